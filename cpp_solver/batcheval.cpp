@@ -0,0 +1,338 @@
+#include "batcheval.h"
+#include "profit.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BATCHEVAL_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+///
+/// \brief Task attributes laid out for gathers, shared by all kernels.
+///
+struct Tables {
+    const int* durations;
+    const int* deadlines;
+    const double* profits;
+    const double* penalties;    // FloatingProfit::latePenaltyTable()
+    int n;
+    int horizon;
+};
+
+double gain(const Tables& t, int task, int time) {
+    int minutesLate = time - t.deadlines[task];
+    return minutesLate > 0 ? t.profits[task] * FloatingProfit::latePenalty(minutesLate) : t.profits[task];
+}
+
+void evaluateScalar(const Tables& t, const int* const* schedules, const int* lengths, int count, double* result) {
+    for (int l = 0; l < count; ++l) {
+        double profit = 0.0;
+        int time = 0;
+        for (int k = 0; k < lengths[l]; ++k) {
+            int task = schedules[l][k];
+            time += t.durations[task];
+            if (time > t.horizon) {
+                break;
+            }
+            profit += gain(t, task, time);
+        }
+        result[l] = profit;
+    }
+}
+
+void evaluateSwapsScalar(const Tables& t, const int* base, int length, const int* is, const int* js, int count,
+                         double* result) {
+    for (int l = 0; l < count; ++l) {
+        double profit = 0.0;
+        int time = 0;
+        for (int k = 0; k < length; ++k) {
+            int task = k == is[l] ? base[js[l]] : k == js[l] ? base[is[l]] : base[k];
+            time += t.durations[task];
+            if (time > t.horizon) {
+                break;
+            }
+            profit += gain(t, task, time);
+        }
+        result[l] = profit;
+    }
+}
+
+#ifdef BATCHEVAL_X86
+
+// Gathers with an explicit source operand, the plain forms read an uninitialized register
+// according to GCC and trip -Wmaybe-uninitialized.
+__attribute__((target("avx2")))
+inline __m128i gather4(const int* base, __m128i idx) {
+    return _mm_mask_i32gather_epi32(_mm_setzero_si128(), base, idx, _mm_set1_epi32(-1), 4);
+}
+
+__attribute__((target("avx2")))
+inline __m256i gather8(const int* base, __m256i idx) {
+    return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), base, idx, _mm256_set1_epi32(-1), 4);
+}
+
+__attribute__((target("avx2")))
+inline __m256d gather4(const double* base, __m128i idx) {
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, idx, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+}
+
+__attribute__((target("avx512f")))
+inline __m512d gather8(const double* base, __m256i idx) {
+    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, base, 8);
+}
+
+// One step of four lanes: adds the tasks idx to the schedules and their gains to acc.
+// Returns false once every lane is past the horizon.
+__attribute__((target("avx2")))
+inline bool stepAvx2(const Tables& t, __m128i idx, __m128i& time, __m256d& acc) {
+    time = _mm_add_epi32(time, gather4(t.durations, idx));
+    __m128i active = _mm_cmpgt_epi32(_mm_set1_epi32(t.horizon + 1), time);
+    if (_mm_movemask_epi8(active) == 0) {
+        return false;
+    }
+    __m128i late = _mm_sub_epi32(time, gather4(t.deadlines, idx));
+    late = _mm_min_epi32(_mm_max_epi32(late, _mm_setzero_si128()), _mm_set1_epi32(MAX_TIME));
+    __m256d gains = _mm256_mul_pd(gather4(t.profits, idx), gather4(t.penalties, late));
+    acc = _mm256_add_pd(acc, _mm256_and_pd(gains, _mm256_castsi256_pd(_mm256_cvtepi32_epi64(active))));
+    return true;
+}
+
+__attribute__((target("avx2")))
+void evaluateAvx2(const Tables& t, const int* const* schedules, const int* lengths, int count, double* result) {
+    for (int first = 0; first < count; first += 4) {
+        int lanes = std::min(4, count - first);
+        const int* s[4];
+        int len[4] = {0, 0, 0, 0};
+        int maxLength = 0;
+        for (int l = 0; l < 4; ++l) {
+            s[l] = l < lanes ? schedules[first + l] : nullptr;
+            len[l] = l < lanes ? lengths[first + l] : 0;
+            maxLength = std::max(maxLength, len[l]);
+        }
+        __m128i time = _mm_setzero_si128();
+        __m256d acc = _mm256_setzero_pd();
+        for (int k = 0; k < maxLength; ++k) {
+            __m128i idx = _mm_setr_epi32(k < len[0] ? s[0][k] : t.n, k < len[1] ? s[1][k] : t.n,
+                                         k < len[2] ? s[2][k] : t.n, k < len[3] ? s[3][k] : t.n);
+            if (!stepAvx2(t, idx, time, acc)) {
+                break;
+            }
+        }
+        double lanesOut[4];
+        _mm256_storeu_pd(lanesOut, acc);
+        std::copy(lanesOut, lanesOut + lanes, result + first);
+    }
+}
+
+__attribute__((target("avx2")))
+void evaluateSwapsAvx2(const Tables& t, const int* base, int length, const int* is, const int* js, int count,
+                       double* result) {
+    for (int first = 0; first < count; first += 4) {
+        int lanes = std::min(4, count - first);
+        int i[4] = {0, 0, 0, 0}, j[4] = {0, 0, 0, 0};
+        std::copy(is + first, is + first + lanes, i);
+        std::copy(js + first, js + first + lanes, j);
+        __m128i iv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+        __m128i jv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(j));
+        __m128i atI = gather4(base, jv);     // task moved to position i
+        __m128i atJ = gather4(base, iv);     // task moved to position j
+        __m128i time = _mm_setzero_si128();
+        __m256d acc = _mm256_setzero_pd();
+        for (int k = 0; k < length; ++k) {
+            __m128i kv = _mm_set1_epi32(k);
+            __m128i idx = _mm_blendv_epi8(_mm_set1_epi32(base[k]), atI, _mm_cmpeq_epi32(kv, iv));
+            idx = _mm_blendv_epi8(idx, atJ, _mm_cmpeq_epi32(kv, jv));
+            if (!stepAvx2(t, idx, time, acc)) {
+                break;
+            }
+        }
+        double lanesOut[4];
+        _mm256_storeu_pd(lanesOut, acc);
+        std::copy(lanesOut, lanesOut + lanes, result + first);
+    }
+}
+
+// Same as stepAvx2 with eight lanes.
+__attribute__((target("avx512f")))
+inline bool stepAvx512(const Tables& t, __m256i idx, __m256i& time, __m512d& acc) {
+    time = _mm256_add_epi32(time, gather8(t.durations, idx));
+    __m256i active = _mm256_cmpgt_epi32(_mm256_set1_epi32(t.horizon + 1), time);
+    __mmask8 mask = static_cast<__mmask8>(_mm256_movemask_ps(_mm256_castsi256_ps(active)));
+    if (mask == 0) {
+        return false;
+    }
+    __m256i late = _mm256_sub_epi32(time, gather8(t.deadlines, idx));
+    late = _mm256_min_epi32(_mm256_max_epi32(late, _mm256_setzero_si256()), _mm256_set1_epi32(MAX_TIME));
+    __m512d gains = _mm512_mul_pd(gather8(t.profits, idx), gather8(t.penalties, late));
+    acc = _mm512_mask_add_pd(acc, mask, acc, gains);
+    return true;
+}
+
+__attribute__((target("avx512f")))
+void evaluateAvx512(const Tables& t, const int* const* schedules, const int* lengths, int count, double* result) {
+    for (int first = 0; first < count; first += 8) {
+        int lanes = std::min(8, count - first);
+        const int* s[8];
+        int len[8];
+        int maxLength = 0;
+        for (int l = 0; l < 8; ++l) {
+            s[l] = l < lanes ? schedules[first + l] : nullptr;
+            len[l] = l < lanes ? lengths[first + l] : 0;
+            maxLength = std::max(maxLength, len[l]);
+        }
+        __m256i time = _mm256_setzero_si256();
+        __m512d acc = _mm512_setzero_pd();
+        for (int k = 0; k < maxLength; ++k) {
+            __m256i idx = _mm256_setr_epi32(k < len[0] ? s[0][k] : t.n, k < len[1] ? s[1][k] : t.n,
+                                            k < len[2] ? s[2][k] : t.n, k < len[3] ? s[3][k] : t.n,
+                                            k < len[4] ? s[4][k] : t.n, k < len[5] ? s[5][k] : t.n,
+                                            k < len[6] ? s[6][k] : t.n, k < len[7] ? s[7][k] : t.n);
+            if (!stepAvx512(t, idx, time, acc)) {
+                break;
+            }
+        }
+        double lanesOut[8];
+        _mm512_storeu_pd(lanesOut, acc);
+        std::copy(lanesOut, lanesOut + lanes, result + first);
+    }
+}
+
+__attribute__((target("avx512f")))
+void evaluateSwapsAvx512(const Tables& t, const int* base, int length, const int* is, const int* js, int count,
+                         double* result) {
+    for (int first = 0; first < count; first += 8) {
+        int lanes = std::min(8, count - first);
+        int i[8] = {0, 0, 0, 0, 0, 0, 0, 0}, j[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        std::copy(is + first, is + first + lanes, i);
+        std::copy(js + first, js + first + lanes, j);
+        __m256i iv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i));
+        __m256i jv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(j));
+        __m256i atI = gather8(base, jv);
+        __m256i atJ = gather8(base, iv);
+        __m256i time = _mm256_setzero_si256();
+        __m512d acc = _mm512_setzero_pd();
+        for (int k = 0; k < length; ++k) {
+            __m256i kv = _mm256_set1_epi32(k);
+            __m256i idx = _mm256_blendv_epi8(_mm256_set1_epi32(base[k]), atI, _mm256_cmpeq_epi32(kv, iv));
+            idx = _mm256_blendv_epi8(idx, atJ, _mm256_cmpeq_epi32(kv, jv));
+            if (!stepAvx512(t, idx, time, acc)) {
+                break;
+            }
+        }
+        double lanesOut[8];
+        _mm512_storeu_pd(lanesOut, acc);
+        std::copy(lanesOut, lanesOut + lanes, result + first);
+    }
+}
+
+#endif // BATCHEVAL_X86
+
+} // namespace
+
+///
+/// \brief Copies the task attributes of the Input and selects the instruction set.
+/// \param in: Problem is specified by this Input.
+/// \param isa: Preferred instruction set, lowered to the best one the CPU supports.
+///
+BatchEvaluator::BatchEvaluator(const Input &in, Isa isa)
+    : n(in.size()), horizon(in.getHorizon()), durations(in.getDurations()), deadlines(in.getDeadlines()),
+      profits(in.getProfits()), isa(std::min(isa, detectIsa())) {
+    durations.push_back(horizon + 1);
+    deadlines.push_back(0);
+    profits.push_back(0.0);
+    if (horizon > MAX_TIME) {
+        this->isa = SCALAR;     // the penalty table only covers MAX_TIME minutes
+    }
+}
+
+///
+/// \brief Returns the instruction set used by this evaluator.
+/// \return Instruction set.
+///
+BatchEvaluator::Isa BatchEvaluator::getIsa() const {
+    return isa;
+}
+
+///
+/// \brief Evaluates schedules of any lengths, trimmed or untrimmed.
+/// \param schedules: Schedules to evaluate.
+/// \param result: Assigned result[k] == schedules[k].evaluate(input).
+///
+void BatchEvaluator::evaluate(const std::vector<Output> &schedules, std::vector<double> &result) const {
+    int count = static_cast<int>(schedules.size());
+    std::vector<const int*> pointers(count);
+    std::vector<int> lengths(count);
+    for (int k = 0; k < count; ++k) {
+        pointers[k] = schedules[k].getSchedule().data();
+        lengths[k] = static_cast<int>(schedules[k].size());
+    }
+    result.resize(count);
+    Tables t = {durations.data(), deadlines.data(), profits.data(), FloatingProfit::latePenaltyTable().data(), n, horizon};
+#ifdef BATCHEVAL_X86
+    if (isa == AVX512) {
+        evaluateAvx512(t, pointers.data(), lengths.data(), count, result.data());
+        return;
+    } else if (isa == AVX2) {
+        evaluateAvx2(t, pointers.data(), lengths.data(), count, result.data());
+        return;
+    }
+#endif
+    evaluateScalar(t, pointers.data(), lengths.data(), count, result.data());
+}
+
+///
+/// \brief Evaluates candidate swap moves from one schedule without applying them.
+/// \param base: Schedule the moves start from.
+/// \param swaps: Pairs of positions below base.size() to swap, equal positions leave base unchanged.
+/// \param result: Assigned result[k] == profit of base with the positions of swaps[k] swapped.
+///
+void BatchEvaluator::evaluateSwaps(const Output &base, const std::vector<std::pair<int, int>> &swaps,
+                                   std::vector<double> &result) const {
+    int count = static_cast<int>(swaps.size());
+    std::vector<int> is(count), js(count);
+    for (int k = 0; k < count; ++k) {
+        is[k] = swaps[k].first;
+        js[k] = swaps[k].second;
+    }
+    result.resize(count);
+    const int* schedule = base.getSchedule().data();
+    int length = static_cast<int>(base.size());
+    Tables t = {durations.data(), deadlines.data(), profits.data(), FloatingProfit::latePenaltyTable().data(), n, horizon};
+#ifdef BATCHEVAL_X86
+    if (isa == AVX512) {
+        evaluateSwapsAvx512(t, schedule, length, is.data(), js.data(), count, result.data());
+        return;
+    } else if (isa == AVX2) {
+        evaluateSwapsAvx2(t, schedule, length, is.data(), js.data(), count, result.data());
+        return;
+    }
+#endif
+    evaluateSwapsScalar(t, schedule, length, is.data(), js.data(), count, result.data());
+}
+
+///
+/// \brief Returns the widest instruction set supported by the CPU.
+/// \return AVX512, AVX2, or SCALAR.
+///
+BatchEvaluator::Isa BatchEvaluator::detectIsa() {
+#ifdef BATCHEVAL_X86
+    if (__builtin_cpu_supports("avx512f")) {
+        return AVX512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        return AVX2;
+    }
+#endif
+    return SCALAR;
+}
+
+///
+/// \brief Returns the name of an instruction set.
+/// \param isa: Instruction set.
+/// \return Name of the instruction set.
+///
+const char *BatchEvaluator::isaName(Isa isa) {
+    static const char* const NAMES[] = {"scalar", "AVX2", "AVX-512"};
+    return NAMES[isa];
+}
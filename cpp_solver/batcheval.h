@@ -0,0 +1,42 @@
+#ifndef BATCHEVAL_H
+#define BATCHEVAL_H
+#include <utility>
+#include <vector>
+#include "input.h"
+#include "output.h"
+
+///
+/// \brief Evaluates many schedules of the same Input at once, one schedule per SIMD lane:
+///        4 lanes with AVX2 or 8 lanes with AVX-512, selected at runtime by CPU feature
+///        detection. Each lane gathers the duration, deadline, and profit of its next task,
+///        advances its own completion time, and looks up the late penalty in the table of
+///        FloatingProfit, so every profit is bit-for-bit equal to Output::evaluate. The
+///        scalar fallback computes the same values one schedule at a time, and is always
+///        used on other CPUs and compilers, or for horizons longer than MAX_TIME.
+///
+class BatchEvaluator
+{
+public:
+    enum Isa { SCALAR, AVX2, AVX512 };
+
+private:
+    int n;
+    int horizon;
+    std::vector<int> durations;     // n + 1 entries, task n is a sentinel that ends every schedule
+    std::vector<int> deadlines;
+    std::vector<double> profits;
+    Isa isa;
+
+public:
+    BatchEvaluator(const Input& in, Isa isa = detectIsa());
+
+    Isa getIsa() const;
+    void evaluate(const std::vector<Output>& schedules, std::vector<double>& result) const;
+    void evaluateSwaps(const Output& base, const std::vector<std::pair<int, int>>& swaps,
+                       std::vector<double>& result) const;
+
+    static Isa detectIsa();
+    static const char* isaName(Isa isa);
+};
+
+#endif // BATCHEVAL_H
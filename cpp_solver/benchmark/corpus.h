@@ -0,0 +1,114 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../input.h"
+#include "../output.h"
+#include "../presets.h"
+
+// Helpers shared by the benchmark programs to locate the instances of the corpus and
+// their best-known results. Paths are relative to cpp_solver.
+
+const std::string CORPUS_INPUT_DIR = "../inputs/";
+const std::string CORPUS_OUTPUT_DIR = "../outputs/";
+const std::string CORPUS_SUBMISSION_FILE = "../submission.json";
+const int CORPUS_INSTANCES_PER_CLASS = 300;
+
+///
+/// \brief Returns the name of an instance, such as "large-17".
+///
+inline std::string instanceName(Portfolio::SizeClass sizeClass, int index) {
+    return std::string(SettingsPresets::className(sizeClass)) + '-' + std::to_string(index);
+}
+
+inline std::string instanceInputFile(Portfolio::SizeClass sizeClass, int index) {
+    return CORPUS_INPUT_DIR + SettingsPresets::className(sizeClass) + '/' + instanceName(sizeClass, index) + ".in";
+}
+
+inline std::string instanceOutputFile(Portfolio::SizeClass sizeClass, int index) {
+    return CORPUS_OUTPUT_DIR + SettingsPresets::className(sizeClass) + '/' + instanceName(sizeClass, index) + ".out";
+}
+
+///
+/// \brief Picks sample distinct instance indices out of 1 to CORPUS_INSTANCES_PER_CLASS.
+/// \param sample: Number of indices, all instances if at least CORPUS_INSTANCES_PER_CLASS.
+/// \param gen: Random generator, the same state always gives the same sample.
+/// \return Indices in increasing order.
+///
+inline std::vector<int> sampleInstances(int sample, std::mt19937_64& gen) {
+    std::vector<int> indices;
+    for (int i = 1; i <= CORPUS_INSTANCES_PER_CLASS; ++i) {
+        indices.push_back(i);
+    }
+    std::shuffle(indices.begin(), indices.end(), gen);
+    indices.resize(std::min(std::max(sample, 0), CORPUS_INSTANCES_PER_CLASS));
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+///
+/// \brief Reads the sequences of submission.json. The file is a flat JSON object
+///        mapping "<name>.in" to the output file content, with lines separated by "\n".
+/// \param fileName: Directory to submission.json.
+/// \return Sequence of each instance by name, without the ".in" extension.
+///
+inline std::map<std::string, Output> readSubmission(const std::string& fileName = CORPUS_SUBMISSION_FILE) {
+    std::map<std::string, Output> result;
+    std::ifstream fs(fileName);
+    std::stringstream buffer;
+    buffer << fs.rdbuf();
+    const std::string text = buffer.str();
+    size_t pos = 0;
+    while ((pos = text.find('"', pos)) != std::string::npos) {
+        size_t keyEnd = text.find('"', pos + 1);
+        size_t valueBegin = text.find('"', keyEnd + 1);
+        size_t valueEnd = text.find('"', valueBegin + 1);
+        if (keyEnd == std::string::npos || valueBegin == std::string::npos || valueEnd == std::string::npos) {
+            break;
+        }
+        std::string key = text.substr(pos + 1, keyEnd - pos - 1);
+        std::string value = text.substr(valueBegin + 1, valueEnd - valueBegin - 1);
+        std::vector<int> schedule;
+        for (size_t k = 0; k < value.size(); ) {
+            if (value[k] >= '0' && value[k] <= '9') {
+                int task = 0;
+                while (k < value.size() && value[k] >= '0' && value[k] <= '9') {
+                    task = task * 10 + (value[k++] - '0');
+                }
+                schedule.push_back(task - 1);
+            } else {
+                k += value[k] == '\\' ? 2 : 1;  // skip escapes such as "\n"
+            }
+        }
+        result[key.substr(0, key.rfind(".in"))] = Output(schedule);
+        pos = valueEnd + 1;
+    }
+    return result;
+}
+
+///
+/// \brief Returns the best known profit of an instance, the better of its file in
+///        outputs/ and its entry in submission.json. Invalid sequences are ignored.
+/// \param in: The instance.
+/// \param sizeClass: Size class of the instance.
+/// \param index: Index of the instance within its size class.
+/// \param submission: Sequences read by readSubmission.
+/// \return Best known profit, zero if neither sequence is valid.
+///
+inline double bestKnownProfit(const Input& in, Portfolio::SizeClass sizeClass, int index,
+                              const std::map<std::string, Output>& submission) {
+    Output known(instanceOutputFile(sizeClass, index));
+    double best = known.isValidFor(in) ? known.evaluate(in) : 0.0;
+    std::map<std::string, Output>::const_iterator it = submission.find(instanceName(sizeClass, index));
+    if (it != submission.end() && it->second.isValidFor(in)) {
+        best = std::max(best, it->second.evaluate(in));
+    }
+    return best;
+}
+
+#endif // CORPUS_H
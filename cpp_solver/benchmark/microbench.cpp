@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../batcheval.h"
+#include "../compactschedule.h"
+#include "../greedysolver.h"
+#include "../input.h"
+#include "../output.h"
+#include "../sasolver.h"
+#include "../schedulestate.h"
+
+using namespace std;
+
+// Build inside cpp_solver with:
+//     g++ -O2 -pthread -o microbench benchmark/microbench.cpp $(ls *.cpp | grep -v main.cpp)
+// Usage: ./microbench [seed]
+
+const int SIZES[] = {100, 150, 200, 1000, 5000};   // The last two are synthetic sizes beyond the project spec.
+const long long TARGET_TASK_VISITS = 20000000;      // Each timed run visits about this many tasks.
+const int MAX_QUADRATIC_SIZE = 1000;                // Larger sizes skip the greedy strategy that takes O(n^2) time.
+const int REPEATS = 5;                              // Each benchmark reports the fastest of this many runs.
+const string TEMP_FILE_NAME = "microbench.tmp";
+
+volatile double sink;   // Keeps the compiler from discarding the benchmarked work.
+
+///
+/// \brief Times the hot paths of the solvers on random Inputs. The Inputs, the
+///        sequences, and the moves are all generated from the seed, so two runs
+///        with the same seed measure exactly the same work.
+///
+class Microbenchmark
+{
+private:
+    int seed;
+
+public:
+    Microbenchmark(int seed) : seed(seed) {}
+
+    void run() {
+        cout << left << setw(36) << "benchmark" << right << setw(8) << "n"
+             << setw(12) << "ops" << setw(14) << "ns/op" << '\n';
+        for (int n : SIZES) {
+            Input in(n, seed);
+            benchEvaluate(in);
+            benchBatchEvaluate(in);
+            benchPerturb(in);
+            benchSwapDelta(in);
+            benchGreedy(in);
+            benchParsers(in);
+        }
+        std::remove(TEMP_FILE_NAME.c_str());
+    }
+
+private:
+    ///
+    /// \brief Calls body(ops) REPEATS times and prints the fastest time per operation.
+    /// \param name: Name of the benchmark.
+    /// \param n: Number of tasks.
+    /// \param ops: Number of operations that body performs.
+    /// \param body: Function performing ops operations.
+    ///
+    template <class F>
+    void report(const string& name, int n, long long ops, F body) {
+        body(std::max(1LL, ops / 10));  // warm up caches and branch predictors
+        double best = 1e300;
+        for (int r = 0; r < REPEATS; ++r) {
+            auto start = chrono::steady_clock::now();
+            body(ops);
+            auto stop = chrono::steady_clock::now();
+            best = std::min(best, chrono::duration<double, std::nano>(stop - start).count());
+        }
+        cout << left << setw(36) << name << right << setw(8) << n
+             << setw(12) << ops << setw(14) << fixed << setprecision(1) << best / ops << endl;
+        cout.unsetf(ios::floatfield);
+    }
+
+    Output randomSequence(const Input& in, mt19937_64& gen) const {
+        vector<int> sequence(in.size());
+        for (int i = 0; i < in.size(); ++i) {
+            sequence[i] = i;
+        }
+        shuffle(sequence.begin(), sequence.end(), gen);
+        return Output(sequence);
+    }
+
+    void benchEvaluate(const Input& in) {
+        mt19937_64 gen(seed);
+        Output out = randomSequence(in, gen);
+        report("Output::evaluate", in.size(), TARGET_TASK_VISITS / in.size(), [&](long long ops) {
+            double total = 0.0;
+            for (long long k = 0; k < ops; ++k) {
+                total += out.evaluate(in);
+            }
+            sink = total;
+        });
+        report("Output::evaluateFixed", in.size(), TARGET_TASK_VISITS / in.size(), [&](long long ops) {
+            long long total = 0;
+            for (long long k = 0; k < ops; ++k) {
+                total += out.evaluateFixed(in);
+            }
+            sink = static_cast<double>(total);
+        });
+        benchCompactEvaluate<GenericPolicy<>>("CompactSchedule<Generic>::evaluate", in, out);
+        if (PresetPolicy<100>::accepts(in)) {
+            benchCompactEvaluate<PresetPolicy<100>>("CompactSchedule<Preset>::evaluate", in, out);
+        } else if (PresetPolicy<150>::accepts(in)) {
+            benchCompactEvaluate<PresetPolicy<150>>("CompactSchedule<Preset>::evaluate", in, out);
+        } else if (PresetPolicy<200>::accepts(in)) {
+            benchCompactEvaluate<PresetPolicy<200>>("CompactSchedule<Preset>::evaluate", in, out);
+        }
+    }
+
+    template <class Policy>
+    void benchCompactEvaluate(const string& name, const Input& in, const Output& out) {
+        CompactSchedule<Policy> schedule(in, out);
+        report(name, in.size(), TARGET_TASK_VISITS / in.size(), [&](long long ops) {
+            double total = 0.0;
+            for (long long k = 0; k < ops; ++k) {
+                total += schedule.evaluate();
+            }
+            sink = total;
+        });
+    }
+
+    ///
+    /// \brief BatchEvaluator with every instruction set the CPU supports, per schedule or move.
+    ///
+    void benchBatchEvaluate(const Input& in) {
+        const int BATCH_SIZE = 64;
+        mt19937_64 gen(seed);
+        vector<Output> outs;
+        vector<pair<int, int>> swaps;
+        uniform_int_distribution<int> indexDist(0, in.size() - 1);
+        for (int k = 0; k < BATCH_SIZE; ++k) {
+            outs.push_back(randomSequence(in, gen));
+            swaps.push_back(make_pair(indexDist(gen), indexDist(gen)));
+        }
+        for (int isa = BatchEvaluator::SCALAR; isa <= BatchEvaluator::detectIsa(); ++isa) {
+            BatchEvaluator evaluator(in, static_cast<BatchEvaluator::Isa>(isa));
+            string name = string("BatchEvaluator ") + BatchEvaluator::isaName(evaluator.getIsa());
+            vector<double> profits;
+            report(name + " schedules", in.size(), TARGET_TASK_VISITS / in.size(), [&](long long ops) {
+                double total = 0.0;
+                for (long long k = 0; k < ops; k += BATCH_SIZE) {
+                    evaluator.evaluate(outs, profits);
+                    total += profits[0];
+                }
+                sink = total;
+            });
+            report(name + " swaps", in.size(), TARGET_TASK_VISITS / in.size(), [&](long long ops) {
+                double total = 0.0;
+                for (long long k = 0; k < ops; k += BATCH_SIZE) {
+                    evaluator.evaluateSwaps(outs[0], swaps, profits);
+                    total += profits[0];
+                }
+                sink = total;
+            });
+        }
+    }
+
+    ///
+    /// \brief One SASolver step: perturb, then accept or undo the swap.
+    ///
+    void benchPerturb(const Input& in) {
+        SASolver sas(in);
+        report("SASolver::perturb+accept/undo", in.size(), TARGET_TASK_VISITS / in.size(), [&](long long ops) {
+            mt19937_64 gen(seed);
+            Output out = SASolver::randomSequence(in, gen);
+            double currProfit = out.evaluate(in);
+            int index1, index2;
+            for (long long k = 0; k < ops; ++k) {
+                double newProfit = sas.perturb(out, index1, index2, gen);
+                if (sas.accProb(-currProfit, -newProfit, 1.0) < sas.uniformRealDist(gen)) {
+                    out.swapTasks(index1, index2);
+                } else {
+                    currProfit = newProfit;
+                }
+            }
+            sink = currProfit;
+        });
+    }
+
+    ///
+    /// \brief The incremental counterpart of benchPerturb, as used by SASolver in fixed-point mode.
+    ///
+    void benchSwapDelta(const Input& in) {
+        report("FixedScheduleState::swapDelta", in.size(), TARGET_TASK_VISITS / in.size(), [&](long long ops) {
+            mt19937_64 gen(seed);
+            uniform_int_distribution<int> dist(0, in.size() - 1);
+            FixedScheduleState state(in, randomSequence(in, gen));
+            long long total = 0;
+            for (long long k = 0; k < ops; ++k) {
+                int i = dist(gen);
+                int j = dist(gen);
+                FixedScheduleState::Value delta = state.swapDelta(i, j);
+                if (delta >= 0) {
+                    state.applySwap(i, j);
+                }
+                total += delta;
+            }
+            sink = static_cast<double>(total);
+        });
+    }
+
+    void benchGreedy(const Input& in) {
+        long long n = in.size();
+        long long ops = std::max(1LL, TARGET_TASK_VISITS / (n * n));
+        GreedySolver gs(in);
+        if (n <= MAX_QUADRATIC_SIZE) {
+            report("GreedySolver::solveMostProfitable", in.size(), ops, [&](long long ops) {
+                for (long long k = 0; k < ops; ++k) {
+                    sink = gs.solveMostProfitable().size();
+                }
+            });
+        }
+        ops = std::max(1LL, TARGET_TASK_VISITS / n / 10);
+        report("GreedySolver::solveLeastOverdue", in.size(), ops / 10, [&](long long ops) {
+            for (long long k = 0; k < ops; ++k) {
+                sink = gs.solveLeastOverdue().size();
+            }
+        });
+        report("GreedySolver::solveDeadline", in.size(), ops, [&](long long ops) {
+            for (long long k = 0; k < ops; ++k) {
+                sink = gs.solveDeadline().size();
+            }
+        });
+        report("GreedySolver::solveProfitRate", in.size(), ops, [&](long long ops) {
+            for (long long k = 0; k < ops; ++k) {
+                sink = gs.solveProfitRate().size();
+            }
+        });
+    }
+
+    void benchParsers(const Input& in) {
+        long long ops = std::max(1LL, TARGET_TASK_VISITS / in.size() / 100);
+        in.writeFile(TEMP_FILE_NAME);
+        report("Input(fileName)", in.size(), ops, [&](long long ops) {
+            for (long long k = 0; k < ops; ++k) {
+                sink = Input(TEMP_FILE_NAME).size();
+            }
+        });
+        mt19937_64 gen(seed);
+        Output out = randomSequence(in, gen);
+        out.writeFile(TEMP_FILE_NAME);
+        report("Output(fileName)", in.size(), ops, [&](long long ops) {
+            for (long long k = 0; k < ops; ++k) {
+                sink = Output(TEMP_FILE_NAME).size();
+            }
+        });
+    }
+};
+
+int main(int argc, char* argv[]) {
+    int seed = argc > 1 ? atoi(argv[1]) : 0;
+    Microbenchmark(seed).run();
+    return 0;
+}
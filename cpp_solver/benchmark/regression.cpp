@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../input.h"
+#include "../output.h"
+#include "../portfolio.h"
+#include "../solver.h"
+#include "corpus.h"
+
+using namespace std;
+
+// Build inside cpp_solver with:
+//     g++ -O2 -pthread -o regression benchmark/regression.cpp $(ls *.cpp | grep -v main.cpp)
+/* Usage: ./regression [--engine SA|Tabu|LAHC|Memetic|Dynasearch|LNS|VNS|Greedy|Naive|Portfolio]
+ *                     [--budget seconds] [--sample instancesPerClass] [--jobs numJobs]
+ *                     [--seed seed] [--baseline curveFile] [--save curveFile]
+ *
+ * Every sampled instance is solved on a single thread for the same time budget, jobs
+ * instances at a time, so the CPU time given to each instance does not depend on jobs.
+ * The gap of an instance at time t is (bestKnown - incumbent(t)) / bestKnown, where
+ * bestKnown is the better of outputs/ and submission.json. The mean gap of each size
+ * class at every checkpoint forms its anytime curve. With --baseline, the program exits
+ * with status 1 if any point of a curve is worse than the same point of the baseline
+ * by more than GAP_TOLERANCE. The baseline must have been saved with the same budget.
+ */
+
+const string CLASS_NAMES[] = {"small", "medium", "large"};
+const double CHECKPOINTS[] = {0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.0};    // Fractions of the time budget.
+const int NUM_CHECKPOINTS = sizeof(CHECKPOINTS) / sizeof(CHECKPOINTS[0]);
+const double GAP_TOLERANCE = 1e-3;  // Mean gaps may exceed the baseline by this much before failing.
+
+struct Options {
+    string engine = "SA";
+    double budget = 5.0;
+    int sample = 10;
+    int jobs = max(1, static_cast<int>(thread::hardware_concurrency()));
+    int seed = 0;
+    string baseline;
+    string save;
+};
+
+struct Instance {
+    int sizeClass;
+    int index;
+    double bestKnown = 0.0;
+    double gaps[NUM_CHECKPOINTS];
+};
+
+///
+/// \brief Returns the incumbent profit at a point of time from an anytime curve.
+/// \param timeline: (seconds, profit) at every improvement, in time order.
+/// \param seconds: Point of time.
+/// \return Best profit found up to that time, zero if none.
+///
+double profitAt(const vector<pair<double, double>>& timeline, double seconds) {
+    double profit = 0.0;
+    for (const pair<double, double>& p : timeline) {
+        if (p.first > seconds) {
+            break;
+        }
+        profit = p.second;
+    }
+    return profit;
+}
+
+///
+/// \brief Solves one instance under the time budget and fills its gaps.
+///
+void solveInstance(Instance& instance, const Options& options, const map<string, Output>& submission) {
+    Portfolio::SizeClass sizeClass = static_cast<Portfolio::SizeClass>(instance.sizeClass);
+    Input in(instanceInputFile(sizeClass, instance.index));
+    if (in.failed()) {
+        fill(instance.gaps, instance.gaps + NUM_CHECKPOINTS, 1.0);
+        return;
+    }
+    instance.bestKnown = bestKnownProfit(in, sizeClass, instance.index, submission);
+
+    const Portfolio portfolio;
+    SolveControl control(options.budget);
+    int seed = options.seed + instance.index;
+    if (options.engine == "Portfolio") {
+        portfolio.solve(in, 1, control, seed);
+    } else {
+        Engine engine = SIMULATED_ANNEALING;
+        engineFromName(options.engine, engine);
+        unique_ptr<Solver> solver = Portfolio::makeSolver(engine, in, portfolio.getConfig(Portfolio::sizeClassOf(in)));
+        Output out = solver->run(seed, 1, control);
+        control.offer(out, out.evaluate(in));
+    }
+    vector<pair<double, double>> timeline = control.getTimeline();
+    for (int c = 0; c < NUM_CHECKPOINTS; ++c) {
+        double profit = profitAt(timeline, CHECKPOINTS[c] * options.budget);
+        instance.gaps[c] = instance.bestKnown > 0 ? (instance.bestKnown - profit) / instance.bestKnown : 0.0;
+    }
+}
+
+///
+/// \brief Writes the mean gap curve of each size class, one "class,seconds,meanGap" line per point.
+///
+void writeCurves(ostream& out, const Options& options, const vector<vector<double>>& curves) {
+    out << "# engine " << options.engine << " budget " << options.budget << '\n';
+    for (int sizeClass = 0; sizeClass < 3; ++sizeClass) {
+        if (curves[sizeClass].empty()) {
+            continue;
+        }
+        for (int c = 0; c < NUM_CHECKPOINTS; ++c) {
+            out << CLASS_NAMES[sizeClass] << ',' << CHECKPOINTS[c] * options.budget << ','
+                << curves[sizeClass][c] << '\n';
+        }
+    }
+}
+
+///
+/// \brief Compares the curves against a baseline saved by a previous run.
+/// \return 0 if no point regressed, 1 if some point regressed, 2 if the baseline cannot be used.
+///
+int compareBaseline(const string& fileName, const Options& options, const vector<vector<double>>& curves) {
+    ifstream fs(fileName);
+    if (!fs.good()) {
+        cerr << "Cannot read baseline " << fileName << '\n';
+        return 2;
+    }
+    string line;
+    getline(fs, line);
+    stringstream header(line);
+    string hash, engineKey, engine, budgetKey;
+    double budget = 0.0;
+    header >> hash >> engineKey >> engine >> budgetKey >> budget;
+    if (budget != options.budget) {
+        cerr << "Baseline was run with a budget of " << budget << " seconds, not " << options.budget << '\n';
+        return 2;
+    }
+    int status = 0;
+    while (getline(fs, line)) {
+        stringstream ss(line);
+        string className;
+        double seconds, baselineGap;
+        if (!getline(ss, className, ',') || !(ss >> seconds) || !ss.ignore() || !(ss >> baselineGap)) {
+            continue;
+        }
+        int sizeClass = static_cast<int>(find(CLASS_NAMES, CLASS_NAMES + 3, className) - CLASS_NAMES);
+        for (int c = 0; sizeClass < 3 && c < NUM_CHECKPOINTS; ++c) {
+            if (curves[sizeClass].empty() || abs(CHECKPOINTS[c] * options.budget - seconds) > 1e-9) {
+                continue;
+            }
+            if (curves[sizeClass][c] > baselineGap + GAP_TOLERANCE) {
+                cerr << "REGRESSION: " << className << " at " << seconds << "s, mean gap "
+                     << curves[sizeClass][c] << " > baseline " << baselineGap << '\n';
+                status = 1;
+            }
+        }
+    }
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int k = 1; k + 1 < argc; k += 2) {
+        string flag = argv[k];
+        string value = argv[k + 1];
+        if (flag == "--engine") {
+            Engine engine;
+            if (engineFromName(value, engine)) {
+                options.engine = engineName(engine);
+            } else if (value == "Portfolio") {
+                options.engine = value;
+            } else {
+                cerr << "Unknown engine " << value << '\n';
+                return 2;
+            }
+        } else if (flag == "--budget") {
+            options.budget = atof(value.c_str());
+        } else if (flag == "--sample") {
+            options.sample = atoi(value.c_str());
+        } else if (flag == "--jobs") {
+            options.jobs = max(1, atoi(value.c_str()));
+        } else if (flag == "--seed") {
+            options.seed = atoi(value.c_str());
+        } else if (flag == "--baseline") {
+            options.baseline = value;
+        } else if (flag == "--save") {
+            options.save = value;
+        } else {
+            cerr << "Unknown option " << flag << '\n';
+            return 2;
+        }
+    }
+
+    // Pick the same instances of each class for the same seed.
+    vector<Instance> instances;
+    mt19937_64 gen(options.seed);
+    for (int sizeClass = 0; sizeClass < 3; ++sizeClass) {
+        for (int i : sampleInstances(options.sample, gen)) {
+            Instance instance;
+            instance.sizeClass = sizeClass;
+            instance.index = i;
+            instances.push_back(instance);
+        }
+    }
+
+    const map<string, Output> submission = readSubmission();
+    atomic<size_t> next(0);
+    vector<thread> workers;
+    for (int j = 0; j < options.jobs; ++j) {
+        workers.emplace_back([&] {
+            for (size_t k = next++; k < instances.size(); k = next++) {
+                solveInstance(instances[k], options, submission);
+            }
+        });
+    }
+    for (thread& t : workers) {
+        t.join();
+    }
+
+    vector<vector<double>> curves(3);
+    vector<int> counts(3, 0);
+    for (const Instance& instance : instances) {
+        curves[instance.sizeClass].resize(NUM_CHECKPOINTS, 0.0);
+        for (int c = 0; c < NUM_CHECKPOINTS; ++c) {
+            curves[instance.sizeClass][c] += instance.gaps[c];
+        }
+        ++counts[instance.sizeClass];
+    }
+    for (int sizeClass = 0; sizeClass < 3; ++sizeClass) {
+        for (double& gap : curves[sizeClass]) {
+            gap /= counts[sizeClass];
+        }
+    }
+
+    cout << "Engine == " << options.engine << ", budget == " << options.budget << " seconds, "
+         << instances.size() << " instances, " << options.jobs << " jobs\n";
+    cout << setw(8) << "class";
+    for (int c = 0; c < NUM_CHECKPOINTS; ++c) {
+        cout << setw(10) << CHECKPOINTS[c] * options.budget;
+    }
+    cout << '\n' << fixed << setprecision(5);
+    for (int sizeClass = 0; sizeClass < 3; ++sizeClass) {
+        if (curves[sizeClass].empty()) {
+            continue;
+        }
+        cout << setw(8) << CLASS_NAMES[sizeClass];
+        for (double gap : curves[sizeClass]) {
+            cout << setw(10) << gap;
+        }
+        cout << '\n';
+    }
+    cout.unsetf(ios::floatfield);
+
+    if (!options.save.empty()) {
+        ofstream fs(options.save);
+        writeCurves(fs, options, curves);
+    }
+    if (!options.baseline.empty()) {
+        return compareBaseline(options.baseline, options, curves);
+    }
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../input.h"
+#include "../output.h"
+#include "../presets.h"
+#include "../sasolver.h"
+#include "../threadpool.h"
+#include "corpus.h"
+
+using namespace std;
+
+// Build inside cpp_solver with:
+//     g++ -O2 -pthread -o tuner benchmark/tuner.cpp $(ls *.cpp | grep -v main.cpp)
+/* Usage: ./tuner [--classes small,medium,large] [--sample instancesPerClass]
+ *                [--target gap] [--jobs numJobs] [--seed seed] [--out presetFile]
+ *                [--alpha a1,a2,...] [--rejections r1,...] [--epoch e1,...] [--accrate p1,...]
+ *
+ * Races every combination of the listed alpha, maxRejections, epochSizeFactor, and
+ * initAccRate values, separately for each size class. In each stage, all surviving
+ * candidates solve the next training instance of the class with SASolver::solve, jobs
+ * candidates at a time. The gap of a candidate on an instance is its distance to the
+ * best known profit relative to it, and its cost is the number of profit evaluations
+ * it performed, which unlike wall-clock time does not depend on the load of the machine.
+ * After MIN_STAGES stages, candidates whose mean gap is clearly worse than the target
+ * and the best candidate, or that cost far more than the cheapest candidate meeting the
+ * target, are eliminated. The cheapest survivor meeting the target, or the survivor with
+ * the smallest mean gap if none does, is written to the preset file loaded by main.cpp.
+ */
+
+const int MIN_STAGES = 2;                   // Stages before the first elimination.
+const double ELIMINATION_MARGIN = 0.02;     // Gap margin at one stage, shrinks with the square root of the stage count.
+const double COST_FACTOR = 2.0;             // Candidates costing more than this times the cheapest qualified one are eliminated.
+
+struct Options {
+    vector<Portfolio::SizeClass> classes = {Portfolio::SMALL, Portfolio::MEDIUM, Portfolio::LARGE};
+    int sample = 8;
+    double target = 0.01;
+    int jobs = max(1, static_cast<int>(thread::hardware_concurrency()) / SASolver::NUM_THREADS);
+    int seed = 0;
+    string out = "sa_presets.txt";
+    vector<double> alphas = {0.9, 0.95, 0.98, 0.99, 0.995};
+    vector<double> rejections = {10, 20, 50};
+    vector<double> epochFactors = {0.25, 0.5, 1.0};
+    vector<double> accRates = {0.5, 0.8};
+};
+
+struct Candidate {
+    SASolver::Settings settings;
+    double totalGap = 0.0;
+    double totalCost = 0.0;
+    double totalSeconds = 0.0;
+    int stages = 0;
+    bool alive = true;
+
+    double meanGap() const { return totalGap / stages; }
+    double meanCost() const { return totalCost / stages; }
+};
+
+vector<double> parseList(const string& text) {
+    vector<double> values;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        values.push_back(atof(item.c_str()));
+    }
+    return values;
+}
+
+///
+/// \brief Runs one candidate on one instance and adds its gap and cost.
+///
+void runCandidate(Candidate& candidate, const Input& in, double bestKnown, int seed) {
+    SASolver sas(in);
+    auto start = chrono::steady_clock::now();
+    Output out = sas.solve(seed, candidate.settings);
+    candidate.totalSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double profit = out.evaluate(in);
+    candidate.totalGap += bestKnown > 0 ? max(0.0, (bestKnown - profit) / bestKnown) : 0.0;
+    for (const SolverMetrics& m : sas.getMetrics()) {
+        candidate.totalCost += m.fullEvaluations + m.incrementalEvaluations;
+    }
+    ++candidate.stages;
+}
+
+///
+/// \brief Eliminates candidates after a stage, always keeping at least one.
+///
+void eliminate(vector<Candidate>& candidates, double target, int stage) {
+    double bestGap = 1e300;
+    double cheapestQualified = 1e300;
+    for (const Candidate& c : candidates) {
+        if (c.alive) {
+            bestGap = min(bestGap, c.meanGap());
+            if (c.meanGap() <= target) {
+                cheapestQualified = min(cheapestQualified, c.meanCost());
+            }
+        }
+    }
+    double gapLimit = max(target, bestGap) + ELIMINATION_MARGIN / sqrt(static_cast<double>(stage));
+    for (Candidate& c : candidates) {
+        if (c.alive && (c.meanGap() > gapLimit || c.meanCost() > COST_FACTOR * cheapestQualified)) {
+            c.alive = false;
+        }
+    }
+}
+
+///
+/// \brief Races the candidates on the training instances of one size class.
+/// \return The chosen candidate.
+///
+Candidate race(Portfolio::SizeClass sizeClass, const Options& options, ThreadPool& pool,
+               const map<string, Output>& submission) {
+    vector<Candidate> candidates;
+    for (double alpha : options.alphas) {
+        for (double maxRejections : options.rejections) {
+            for (double epochSizeFactor : options.epochFactors) {
+                for (double initAccRate : options.accRates) {
+                    Candidate c;
+                    c.settings = SASolver::Settings(0, alpha, static_cast<int>(maxRejections), epochSizeFactor, initAccRate);
+                    candidates.push_back(c);
+                }
+            }
+        }
+    }
+
+    mt19937_64 gen(options.seed + sizeClass);
+    int stage = 0;
+    for (int index : sampleInstances(options.sample, gen)) {
+        Input in(instanceInputFile(sizeClass, index));
+        if (in.failed()) {
+            continue;
+        }
+        double bestKnown = bestKnownProfit(in, sizeClass, index, submission);
+        vector<Candidate*> alive;
+        for (Candidate& c : candidates) {
+            if (c.alive) {
+                alive.push_back(&c);
+            }
+        }
+        pool.parallelFor(static_cast<int>(alive.size()), [&](int k) {
+            runCandidate(*alive[k], in, bestKnown, options.seed + index);
+        });
+        ++stage;
+        if (stage >= MIN_STAGES) {
+            eliminate(candidates, options.target, stage);
+        }
+        cout << SettingsPresets::className(sizeClass) << " stage " << stage << " (" << instanceName(sizeClass, index)
+             << "): " << alive.size() << " candidates raced, "
+             << count_if(candidates.begin(), candidates.end(), [](const Candidate& c) { return c.alive; })
+             << " survive" << endl;
+    }
+
+    const Candidate* chosen = nullptr;
+    for (const Candidate& c : candidates) {
+        if (!c.alive || c.stages == 0) {
+            continue;
+        }
+        bool qualified = c.meanGap() <= options.target;
+        if (!chosen) {
+            chosen = &c;
+        } else if (qualified && (chosen->meanGap() > options.target || c.meanCost() < chosen->meanCost())) {
+            chosen = &c;
+        } else if (!qualified && chosen->meanGap() > options.target && c.meanGap() < chosen->meanGap()) {
+            chosen = &c;
+        }
+    }
+    return chosen ? *chosen : candidates.front();
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int k = 1; k + 1 < argc; k += 2) {
+        string flag = argv[k];
+        string value = argv[k + 1];
+        if (flag == "--classes") {
+            options.classes.clear();
+            stringstream ss(value);
+            string name;
+            while (getline(ss, name, ',')) {
+                for (int c = Portfolio::SMALL; c <= Portfolio::LARGE; ++c) {
+                    if (name == SettingsPresets::className(static_cast<Portfolio::SizeClass>(c))) {
+                        options.classes.push_back(static_cast<Portfolio::SizeClass>(c));
+                    }
+                }
+            }
+        } else if (flag == "--sample") {
+            options.sample = atoi(value.c_str());
+        } else if (flag == "--target") {
+            options.target = atof(value.c_str());
+        } else if (flag == "--jobs") {
+            options.jobs = max(1, atoi(value.c_str()));
+        } else if (flag == "--seed") {
+            options.seed = atoi(value.c_str());
+        } else if (flag == "--out") {
+            options.out = value;
+        } else if (flag == "--alpha") {
+            options.alphas = parseList(value);
+        } else if (flag == "--rejections") {
+            options.rejections = parseList(value);
+        } else if (flag == "--epoch") {
+            options.epochFactors = parseList(value);
+        } else if (flag == "--accrate") {
+            options.accRates = parseList(value);
+        } else {
+            cerr << "Unknown option " << flag << '\n';
+            return 2;
+        }
+    }
+
+    // Classes that are not tuned keep the presets already in the file.
+    SettingsPresets presets;
+    presets.readFile(options.out);
+    const map<string, Output> submission = readSubmission();
+    ThreadPool pool(options.jobs);
+    for (Portfolio::SizeClass sizeClass : options.classes) {
+        Candidate chosen = race(sizeClass, options, pool, submission);
+        presets.set(sizeClass, chosen.settings);
+        cout << SettingsPresets::className(sizeClass) << " preset: alpha == " << chosen.settings.alpha
+             << ", maxRejections == " << chosen.settings.maxRejections
+             << ", epochSizeFactor == " << chosen.settings.epochSizeFactor
+             << ", initAccRate == " << chosen.settings.initAccRate
+             << ", mean gap == " << chosen.meanGap()
+             << ", mean evaluations == " << chosen.meanCost()
+             << ", mean seconds == " << chosen.totalSeconds / max(chosen.stages, 1) << endl;
+    }
+    presets.writeFile(options.out);
+    return 0;
+}
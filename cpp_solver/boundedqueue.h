@@ -0,0 +1,74 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+///
+/// \brief A first-in first-out queue between threads that holds at most a fixed number
+///        of items. Producers block while it is full and consumers while it is empty, so
+///        a fast stage of a pipeline cannot run ahead of a slow one by more than the
+///        capacity. Once closed, pushes fail and pops drain the remaining items.
+///
+template <class T>
+class BoundedQueue
+{
+private:
+    std::deque<T> items;
+    size_t capacity;
+    bool closed = false;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+
+public:
+    BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator =(const BoundedQueue&) = delete;
+
+    ///
+    /// \brief Appends an item, blocking while the queue is full.
+    /// \param item: Item to append.
+    /// \return False if the queue was closed, in which case the item is dropped.
+    ///
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    ///
+    /// \brief Removes the first item, blocking while the queue is empty and open.
+    /// \param item: Assigned the first item.
+    /// \return False if the queue is closed and empty.
+    ///
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    ///
+    /// \brief Wakes every blocked thread; later pushes fail and pops fail once empty.
+    ///
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
+
+#endif // BOUNDEDQUEUE_H
@@ -0,0 +1,331 @@
+#include "bulkpipeline.h"
+#include "boundedqueue.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+void skipSpace(const std::string& s, size_t& pos) {
+    while (pos < s.size() && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\r' || s[pos] == '\n')) {
+        ++pos;
+    }
+}
+
+void appendUtf8(std::string& out, unsigned code) {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+bool parseJsonString(const std::string& s, size_t& pos, std::string& value) {
+    if (pos >= s.size() || s[pos] != '"') {
+        return false;
+    }
+    value.clear();
+    for (++pos; pos < s.size(); ++pos) {
+        char c = s[pos];
+        if (c == '"') {
+            ++pos;
+            return true;
+        } else if (c != '\\') {
+            value += c;
+        } else if (++pos < s.size()) {
+            switch (s[pos]) {
+            case 'n': value += '\n'; break;
+            case 't': value += '\t'; break;
+            case 'r': value += '\r'; break;
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'u': {
+                unsigned code;
+                if (pos + 4 >= s.size() || sscanf(s.substr(pos + 1, 4).c_str(), "%4x", &code) != 1) {
+                    return false;
+                }
+                appendUtf8(value, code);
+                pos += 4;
+                break;
+            }
+            default: value += s[pos]; break;    // \" \\ \/
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+///
+/// \brief Initializes the pipeline.
+/// \param s: Settings of the pipeline.
+/// \param portfolio: Portfolio that solves instances if s.usePortfolio, and whose
+///        configurations hold the settings of s.engine otherwise.
+///
+BulkPipeline::BulkPipeline(const Settings &s, const Portfolio &portfolio) : settings(s), portfolio(portfolio) {
+    settings.numWorkers = std::max(1, settings.numWorkers);
+    settings.capacity = std::max(settings.numWorkers, settings.capacity);
+}
+
+///
+/// \brief Solves every instance of the input stream and writes the results.
+/// \param in: Stream of instances in the input format of the settings.
+/// \param out: Receives the results in the output format of the settings.
+/// \param err: Receives a line for every record that cannot be read or parsed.
+/// \return Counts and total profit of the results.
+///
+BulkPipeline::Summary BulkPipeline::run(std::istream &in, std::ostream &out, std::ostream &err) {
+    BoundedQueue<Record> records(settings.capacity);
+    BoundedQueue<Result> results(settings.capacity);
+    std::thread reader([&] {
+        readRecords(in, err, [&](Record& record) {
+            acquireSlot();
+            return records.push(std::move(record));
+        });
+        records.close();
+    });
+    std::atomic<int> activeWorkers(settings.numWorkers);
+    std::vector<std::thread> workers;
+    for (int w = 0; w < settings.numWorkers; ++w) {
+        workers.emplace_back([&] {
+            Record record;
+            while (records.pop(record)) {
+                results.push(solveRecord(record));
+            }
+            if (--activeWorkers == 0) {
+                results.close();
+            }
+        });
+    }
+
+    // Write on the calling thread, holding back results that complete early in arrival order.
+    Summary summary;
+    bool first = true;
+    auto write = [&](const Result& result) {
+        if (!result.error.empty()) {
+            err << result.name << ": " << result.error << std::endl;
+            ++summary.failed;
+        } else if (settings.outputFormat == JSON) {
+            out << (first ? "{" : ",") << '\n' << quoteJson(result.name) << ": " << quoteJson(result.text);
+            first = false;
+            ++summary.solved;
+        } else {
+            out << '{' << quoteJson(result.name) << ": " << quoteJson(result.text) << '}' << std::endl;
+            ++summary.solved;
+        }
+        summary.totalProfit += result.profit;
+        releaseSlot();
+    };
+    std::map<long long, Result> heldBack;
+    long long nextIndex = 0;
+    Result result;
+    while (results.pop(result)) {
+        if (!settings.arrivalOrder) {
+            write(result);
+            continue;
+        }
+        heldBack[result.index] = std::move(result);
+        while (!heldBack.empty() && heldBack.begin()->first == nextIndex) {
+            write(heldBack.begin()->second);
+            heldBack.erase(heldBack.begin());
+            ++nextIndex;
+        }
+    }
+    if (settings.outputFormat == JSON) {
+        out << (first ? "{" : "\n") << "}\n";
+    }
+    out.flush();
+    reader.join();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+    return summary;
+}
+
+///
+/// \brief Parses a JSON object whose values are all strings, such as submission.json.
+/// \param line: Text of the object.
+/// \param members: Assigned the (name, value) pairs of the object in order.
+/// \param error: Assigned a description of the problem if the text is not such an object.
+/// \return False if the text is not such an object.
+///
+bool BulkPipeline::parseJsonObject(const std::string &line, std::vector<std::pair<std::string, std::string>> &members,
+                                   std::string &error) {
+    members.clear();
+    size_t pos = 0;
+    skipSpace(line, pos);
+    if (pos >= line.size() || line[pos] != '{') {
+        error = "expected a JSON object";
+        return false;
+    }
+    ++pos;
+    skipSpace(line, pos);
+    if (pos < line.size() && line[pos] == '}') {
+        ++pos;
+    } else {
+        while (true) {
+            std::pair<std::string, std::string> member;
+            skipSpace(line, pos);
+            if (!parseJsonString(line, pos, member.first)) {
+                error = "expected a name at column " + std::to_string(pos + 1);
+                return false;
+            }
+            skipSpace(line, pos);
+            if (pos >= line.size() || line[pos++] != ':') {
+                error = "expected ':' at column " + std::to_string(pos);
+                return false;
+            }
+            skipSpace(line, pos);
+            if (!parseJsonString(line, pos, member.second)) {
+                error = "expected a string at column " + std::to_string(pos + 1);
+                return false;
+            }
+            members.push_back(member);
+            skipSpace(line, pos);
+            if (pos < line.size() && line[pos] == ',') {
+                ++pos;
+            } else if (pos < line.size() && line[pos] == '}') {
+                ++pos;
+                break;
+            } else {
+                error = "expected ',' or '}' at column " + std::to_string(pos + 1);
+                return false;
+            }
+        }
+    }
+    skipSpace(line, pos);
+    if (pos < line.size()) {
+        error = "unexpected content after the object at column " + std::to_string(pos + 1);
+        return false;
+    }
+    return true;
+}
+
+///
+/// \brief Quotes a string for JSON.
+/// \param text: Any text.
+/// \return The text in double quotes with special characters escaped.
+///
+std::string BulkPipeline::quoteJson(const std::string &text) {
+    std::string res = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            res += '\\';
+            res += c;
+        } else if (c == '\n') {
+            res += "\\n";
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            res += escaped;
+        } else {
+            res += c;
+        }
+    }
+    return res + '"';
+}
+
+///
+/// \brief Splits the input stream into records, see the class description for the formats.
+///        Lines that cannot be split into records are reported and skipped.
+/// \param in: Stream of instances.
+/// \param err: Receives a line for every line skipped.
+/// \param emit: Called with every record in order, reading stops if it returns false.
+///
+void BulkPipeline::readRecords(std::istream &in, std::ostream &err, const std::function<bool (Record &)> &emit) {
+    std::string line;
+    long long index = 0;
+    long long lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        if (settings.inputFormat == JSONL_INPUT) {
+            std::vector<std::pair<std::string, std::string>> members;
+            std::string error;
+            if (!parseJsonObject(line, members, error)) {
+                err << "line " << lineNumber << ": " << error << std::endl;
+                continue;
+            }
+            for (std::pair<std::string, std::string>& member : members) {
+                Record record = {index++, member.first, member.second};
+                if (!emit(record)) {
+                    return;
+                }
+            }
+            continue;
+        }
+        int n;
+        if (!(std::istringstream(line) >> n) || n < 0) {
+            err << "line " << lineNumber << ": expected the number of tasks" << std::endl;
+            continue;
+        }
+        Record record = {index, std::to_string(index + 1), line + '\n'};
+        ++index;
+        for (int i = 0; i < n && std::getline(in, line); ++i) {
+            ++lineNumber;
+            record.text += line + '\n';
+        }
+        if (!emit(record)) {
+            return;
+        }
+    }
+}
+
+///
+/// \brief Parses, solves, and formats one record on the calling worker.
+/// \param record: Record to solve.
+/// \return Output file contents of the best sequence found, or why the record failed,
+///         including records whose input violates the spec.
+///
+BulkPipeline::Result BulkPipeline::solveRecord(const Record &record) const {
+    Result result = {record.index, record.name, "", "", 0.0};
+    Input input = Input::fromText(record.text, record.name);
+    if (!input.isValid()) {     // solvers assume the spec, see Input
+        result.error = input.getError();
+        return result;
+    }
+    SolveControl control(settings.timeBudget);
+    int seed = settings.seed + static_cast<int>(record.index);
+    Output best = settings.usePortfolio
+            ? portfolio.solve(input, settings.coresPerInstance, control, seed)
+            : portfolio.solveWith(settings.engine, input, settings.coresPerInstance, control, seed);
+    best.trim(input);
+    result.profit = best.evaluate(input);
+    std::ostringstream text;
+    for (int task : best.getSchedule()) {
+        text << task + 1 << '\n';
+    }
+    result.text = text.str();
+    return result;
+}
+
+///
+/// \brief Blocks while Settings::capacity records are between reading and writing.
+///
+void BulkPipeline::acquireSlot() {
+    std::unique_lock<std::mutex> lock(slotMutex);
+    slotFreed.wait(lock, [this] { return inFlight < settings.capacity; });
+    ++inFlight;
+}
+
+///
+/// \brief Frees the slot of a record once it is written.
+///
+void BulkPipeline::releaseSlot() {
+    {
+        std::lock_guard<std::mutex> lock(slotMutex);
+        --inFlight;
+    }
+    slotFreed.notify_one();
+}
@@ -0,0 +1,120 @@
+#ifndef BULKPIPELINE_H
+#define BULKPIPELINE_H
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "portfolio.h"
+#include "solver.h"
+
+///
+/// \brief Solves a stream of instances of any length with bounded memory. A reader thread
+///        splits the input stream into records, worker threads parse, solve, and format
+///        them, and the calling thread writes the results to one output stream, so the
+///        stages overlap. At most Settings::capacity records are between reading and
+///        writing at any time, however long the stream is.
+///
+///        Input streams are either concatenated input files (IN), each ending with a line
+///        break and named by its position in the stream starting from 1, or JSON lines (JSONL) of objects mapping names to
+///        input file contents, e.g. {"small-1.in": "100\n1 ...\n"}. Results are written
+///        as JSON lines mapping names to output file contents (JSONL), or as a single JSON
+///        object in the format of submission.json (JSON).
+///
+class BulkPipeline
+{
+public:
+    enum InputFormat { IN, JSONL_INPUT };
+    enum OutputFormat { JSONL_OUTPUT, JSON };
+
+    struct Settings {
+        bool usePortfolio;          // Solve with the portfolio of the size class if true, engine otherwise.
+        Engine engine;
+        double timeBudget;          // Wall-clock seconds per instance.
+        int coresPerInstance;
+        int numWorkers;             // Instances solved at the same time.
+        int capacity;               // Maximum number of records between reading and writing.
+        bool arrivalOrder;          // Write results in input order if true, as they complete otherwise.
+        InputFormat inputFormat;
+        OutputFormat outputFormat;
+        int seed;
+
+        Settings(bool usePortfolio = false,
+                 Engine engine = SIMULATED_ANNEALING,
+                 double timeBudget = 1.0,
+                 int coresPerInstance = 1,
+                 int numWorkers = 1,
+                 int capacity = 64,
+                 bool arrivalOrder = true,
+                 InputFormat inputFormat = IN,
+                 OutputFormat outputFormat = JSONL_OUTPUT,
+                 int seed = 0) {
+            this->usePortfolio = usePortfolio;
+            this->engine = engine;
+            this->timeBudget = timeBudget;
+            this->coresPerInstance = coresPerInstance;
+            this->numWorkers = numWorkers;
+            this->capacity = capacity;
+            this->arrivalOrder = arrivalOrder;
+            this->inputFormat = inputFormat;
+            this->outputFormat = outputFormat;
+            this->seed = seed;
+        }
+
+        friend std::ostream& operator <<(std::ostream& out, const Settings& s) {
+            out << "Engine == " << (s.usePortfolio ? "portfolio" : engineName(s.engine)) << '\n';
+            out << "Time budget per instance == " << s.timeBudget << '\n';
+            out << "Cores per instance == " << s.coresPerInstance << '\n';
+            out << "Workers == " << s.numWorkers << '\n';
+            out << "Capacity == " << s.capacity << '\n';
+            out << "Order == " << (s.arrivalOrder ? "arrival" : "completion") << '\n';
+            return out;
+        }
+    };
+
+    struct Summary {
+        long long solved = 0;
+        long long failed = 0;       // Records that could not be parsed, reported on the error stream.
+        double totalProfit = 0.0;
+    };
+
+private:
+    struct Record {
+        long long index;
+        std::string name;
+        std::string text;
+    };
+    struct Result {
+        long long index;
+        std::string name;
+        std::string text;           // Output file contents, empty if failed.
+        std::string error;
+        double profit;
+    };
+
+    Settings settings;
+    Portfolio portfolio;
+
+    std::mutex slotMutex;
+    std::condition_variable slotFreed;
+    int inFlight = 0;
+
+public:
+    BulkPipeline(const Settings& s = Settings(), const Portfolio& portfolio = Portfolio());
+
+    Summary run(std::istream& in, std::ostream& out, std::ostream& err);
+
+    static bool parseJsonObject(const std::string& line, std::vector<std::pair<std::string, std::string>>& members,
+                                std::string& error);
+    static std::string quoteJson(const std::string& text);
+
+private:
+    void readRecords(std::istream& in, std::ostream& err, const std::function<bool(Record&)>& emit);
+    Result solveRecord(const Record& record) const;
+    void acquireSlot();
+    void releaseSlot();
+};
+
+#endif // BULKPIPELINE_H
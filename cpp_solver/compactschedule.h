@@ -0,0 +1,189 @@
+#ifndef COMPACTSCHEDULE_H
+#define COMPACTSCHEDULE_H
+#include "input.h"
+#include "output.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+///
+/// \brief Late penalty of the project: a task finishing minutesLate minutes after its
+///        deadline earns its profit times exp(-LATE_DECAY_RATE * minutesLate). Problem
+///        policies build their penalty tables from factor(), which computes exactly what
+///        Output::evaluate does.
+///
+struct ProjectDecay {
+    static double factor(int minutesLate) {
+        return minutesLate > 0 ? exp(-LATE_DECAY_RATE * minutesLate) : 1.0;
+    }
+};
+
+///
+/// \brief Problem policy of instances with at most MaxTasks tasks and a horizon of Horizon
+///        minutes, such as the 100, 150, and 200 task presets of the project. Schedules are
+///        fixed-capacity arrays of Index that live on the stack instead of the heap, one byte
+///        per task by default, and the late penalty of Decay is tabulated up to the horizon,
+///        which is a compile-time constant. Only valid Inputs are accepted: their deadlines
+///        are at least 1, so no task is late by Horizon minutes or more.
+///
+template <int MaxTasks, int Horizon = MAX_TIME, class Index = uint8_t, class Decay = ProjectDecay>
+struct PresetPolicy {
+    static_assert(MaxTasks > 0 && MaxTasks - 1 <= std::numeric_limits<Index>::max(),
+                  "task indices must fit in Index");
+    static_assert(Horizon > 0 && Horizon <= INT16_MAX, "deadlines must fit in the task attributes");
+
+    typedef std::array<Index, MaxTasks> Order;
+    typedef std::array<int16_t, MaxTasks> Times;
+    typedef std::array<double, MaxTasks> Profits;
+
+    static bool accepts(const Input& in) {
+        return in.isValid() && in.size() <= MaxTasks && in.getHorizon() == Horizon;
+    }
+    static int size(int n) {
+        return n;
+    }
+    static int horizon(int) {
+        return Horizon;
+    }
+    template <class Array>
+    static void resize(Array&, int) {}
+    static const double* latePenaltyTable() {
+        static const std::array<double, Horizon + 1> table = [] {
+            std::array<double, Horizon + 1> t;
+            for (int m = 0; m <= Horizon; ++m) {
+                t[m] = Decay::factor(m);
+            }
+            return t;
+        }();
+        return table.data();
+    }
+    static double latePenalty(const double* table, int minutesLate) {
+        return table[minutesLate];  // minutesLate < Horizon since deadlines are at least 1
+    }
+};
+
+///
+/// \brief Problem policy of arbitrary instances: any number of tasks and any horizon, read
+///        from the Input at runtime.
+///
+template <class Index = int, class Decay = ProjectDecay>
+struct GenericPolicy {
+    typedef std::vector<Index> Order;
+    typedef std::vector<int> Times;
+    typedef std::vector<double> Profits;
+
+    static bool accepts(const Input&) {
+        return true;
+    }
+    static int size(int n) {
+        return n;
+    }
+    static int horizon(int horizon) {
+        return horizon;
+    }
+    template <class Array>
+    static void resize(Array& a, int n) {
+        a.resize(n);
+    }
+    static const double* latePenaltyTable() {
+        static const std::vector<double> table = [] {
+            std::vector<double> t(MAX_TIME + 1);
+            for (int m = 0; m <= MAX_TIME; ++m) {
+                t[m] = Decay::factor(m);
+            }
+            return t;
+        }();
+        return table.data();
+    }
+    static double latePenalty(const double* table, int minutesLate) {
+        return minutesLate <= MAX_TIME ? table[minutesLate] : Decay::factor(minutesLate);
+    }
+};
+
+///
+/// \brief A task sequence bundled with the task attributes it needs for evaluation, laid
+///        out by the problem policy. Every task is in the sequence exactly once, as in the
+///        sequences of SASolver, and evaluate() returns exactly Output::evaluate.
+///
+template <class Policy>
+class CompactSchedule
+{
+private:
+    typename Policy::Order order;       // task at each position
+    typename Policy::Times durations;
+    typename Policy::Times deadlines;
+    typename Policy::Profits profits;
+    const double* penalties;            // Policy::latePenaltyTable()
+    int n;
+    int horizon;
+
+public:
+    ///
+    /// \brief Initializes the schedule from a sequence of all tasks of the Input.
+    /// \param in: Problem is specified by this Input, accepted by the policy.
+    /// \param sequence: Sequence of every task of the Input.
+    ///
+    CompactSchedule(const Input& in, const Output& sequence)
+        : penalties(Policy::latePenaltyTable()), n(in.size()), horizon(in.getHorizon()) {
+        Policy::resize(order, n);
+        Policy::resize(durations, n);
+        Policy::resize(deadlines, n);
+        Policy::resize(profits, n);
+        for (int i = 0; i < n; ++i) {
+            order[i] = static_cast<typename Policy::Order::value_type>(sequence.getSchedule()[i]);
+            durations[i] = in.getDuration(i);
+            deadlines[i] = in.getDeadline(i);
+            profits[i] = in.getProfit(i);
+        }
+    }
+
+    ///
+    /// \brief Returns the profit of the sequence, equal to Output::evaluate.
+    /// \return Profit of the sequence.
+    ///
+    double evaluate() const {
+        double res = 0;
+        int time = 0;
+        for (int i = 0; i < Policy::size(n); ++i) {
+            int task = order[i];
+            time += durations[task];
+            if (time > Policy::horizon(horizon)) {
+                break;
+            }
+            int minutesLate = time - deadlines[task];
+            res += minutesLate > 0 ? profits[task] * Policy::latePenalty(penalties, minutesLate) : profits[task];
+        }
+        return res;
+    }
+
+    ///
+    /// \brief Replaces the sequence, keeping the task attributes.
+    /// \param sequence: Sequence of every task of the Input.
+    ///
+    void assign(const Output& sequence) {
+        for (int i = 0; i < n; ++i) {
+            order[i] = static_cast<typename Policy::Order::value_type>(sequence.getSchedule()[i]);
+        }
+    }
+
+    ///
+    /// \brief Swaps the tasks at two positions.
+    /// \param index1: Position below the number of tasks.
+    /// \param index2: Position below the number of tasks.
+    ///
+    void swapTasks(int index1, int index2) {
+        std::swap(order[index1], order[index2]);
+    }
+
+    ///
+    /// \brief Returns the sequence as an untrimmed Output.
+    /// \return Sequence of every task.
+    ///
+    Output toOutput() const {
+        return Output(std::vector<int>(order.begin(), order.begin() + n));
+    }
+};
+
+#endif // COMPACTSCHEDULE_H
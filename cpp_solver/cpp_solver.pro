@@ -4,18 +4,71 @@ CONFIG -= app_bundle
 CONFIG -= qt
 
 SOURCES += \
+        batcheval.cpp \
+        bulkpipeline.cpp \
+        dynasearch.cpp \
+        dynasearchsolver.cpp \
+        filereader.cpp \
         greedysolver.cpp \
+        incrementalsolver.cpp \
         input.cpp \
+        lahcsolver.cpp \
+        leasequeue.cpp \
+        lnssolver.cpp \
+        localsearch.cpp \
         main.cpp \
+        memeticsolver.cpp \
         naivesolver.cpp \
         output.cpp \
+        packedcorpus.cpp \
+        portfolio.cpp \
+        presets.cpp \
+        profit.cpp \
+        resultcache.cpp \
         sasolver.cpp \
-        tests.cpp
+        schedulestate.cpp \
+        solver.cpp \
+        solvermetrics.cpp \
+        solveservice.cpp \
+        tabusolver.cpp \
+        tests.cpp \
+        threadplacement.cpp \
+        threadpool.cpp \
+        trace.cpp \
+        vnssolver.cpp
 
 HEADERS += \
+    batcheval.h \
+    boundedqueue.h \
+    bulkpipeline.h \
+    compactschedule.h \
+    dynasearch.h \
+    dynasearchsolver.h \
+    filereader.h \
     greedysolver.h \
+    hash.h \
+    incrementalsolver.h \
     input.h \
+    lahcsolver.h \
+    leasequeue.h \
+    lnssolver.h \
+    localsearch.h \
+    memeticsolver.h \
     naivesolver.h \
     output.h \
+    packedcorpus.h \
+    portfolio.h \
+    presets.h \
+    profit.h \
+    resultcache.h \
     sasolver.h \
-    tests.h
+    schedulestate.h \
+    solver.h \
+    solvermetrics.h \
+    solveservice.h \
+    tabusolver.h \
+    tests.h \
+    threadplacement.h \
+    threadpool.h \
+    trace.h \
+    vnssolver.h
@@ -0,0 +1,98 @@
+#include "dynasearch.h"
+#include <algorithm>
+#include <vector>
+
+///
+/// \brief Initializes a dynasearch instance using the Input.
+/// \param in: Problem is specified by this Input.
+/// \param maxSpan: If positive, a move spans at most this many positions beyond the
+///        first, which bounds a pass to O(n * maxSpan^2) for large instances.
+///
+Dynasearch::Dynasearch(const Input &in, int maxSpan) : input(in), maxSpan(maxSpan) {}
+
+///
+/// \brief Descends from an Output to a local optimum of the dynasearch neighbourhood.
+/// \param output: Initial task sequence, possibly trimmed. Missing tasks are appended.
+/// \return The local optimum, its profit, and the number of passes and moves applied.
+///
+Dynasearch::Result Dynasearch::polish(const Output &output) const {
+    FixedScheduleState state(input, output);
+    Result result;
+    result.passes = descend(state, &result.moves);
+    result.output = state.toOutput();
+    result.profit = result.output.evaluate(input);
+    return result;
+}
+
+///
+/// \brief Applies improving passes until none is left.
+/// \param state: Sequence to improve, for the Input of this dynasearch.
+/// \param moves: If specified, the number of moves applied is added to it.
+/// \return Number of improving passes.
+///
+int Dynasearch::descend(FixedScheduleState &state, int *moves) const {
+    int passes = 0;
+    for (int applied = pass(state); applied > 0; applied = pass(state)) {
+        ++passes;
+        if (moves) {
+            *moves += applied;
+        }
+    }
+    return passes;
+}
+
+///
+/// \brief Applies the most profitable set of independent moves. best[e] is the largest
+///        profit gain of moves within the first e positions: either position e - 1 is left
+///        in place, or the last move covers positions i to e - 1 and adds to best[i]. Moves
+///        entirely past the global deadline never change the profit and are skipped.
+/// \param state: Sequence to improve, for the Input of this dynasearch.
+/// \return Number of moves applied, 0 if the sequence is a local optimum.
+///
+int Dynasearch::pass(FixedScheduleState &state) const {
+    enum MoveType { NONE, SWAP, INSERT_FORWARD, INSERT_BACKWARD };
+    typedef FixedScheduleState::Value Value;
+    int n = state.size();
+    if (n < 2) {
+        return 0;
+    }
+    int cutoff = std::min(state.cutoff(), n - 1);
+    int span = maxSpan > 0 ? maxSpan : n;
+
+    std::vector<Value> best(n + 1, 0);
+    std::vector<int> first(n + 1, 0);   // First position of the last move within the first e positions
+    std::vector<int> type(n + 1, NONE);
+    for (int last = 1; last < n; ++last) {
+        int e = last + 1;
+        best[e] = best[last];
+        for (int i = std::max(0, last - span); i < last && i <= cutoff; ++i) {
+            Value deltas[] = {state.swapDelta(i, last), state.insertDelta(i, last), state.insertDelta(last, i)};
+            for (int t = 0; t < 3; ++t) {
+                if (deltas[t] > 0 && best[i] + deltas[t] > best[e]) {
+                    best[e] = best[i] + deltas[t];
+                    first[e] = i;
+                    type[e] = SWAP + t;
+                }
+            }
+        }
+    }
+
+    int moves = 0;
+    for (int e = n; e > 0; ) {
+        if (type[e] == NONE) {
+            --e;
+            continue;
+        }
+        int i = first[e];
+        if (type[e] == SWAP) {
+            state.applySwap(i, e - 1);
+        } else if (type[e] == INSERT_FORWARD) {
+            state.applyInsert(i, e - 1);
+        } else {
+            state.applyInsert(e - 1, i);
+        }
+        ++moves;
+        e = i;
+    }
+    return moves;
+}
@@ -0,0 +1,205 @@
+#include "dynasearchsolver.h"
+#include <algorithm>
+#include <thread>
+
+DynasearchSolver::DynasearchSolver() {}
+
+///
+/// \brief Initializes a solver instance using the Input.
+/// \param in: Problem is specified by this Input.
+/// \param s: Settings used by run().
+///
+DynasearchSolver::DynasearchSolver(const Input &in, const Settings &s) {
+    input = in;
+    settings = s;
+}
+
+///
+/// \brief Solves the problem with the seed and settings specified.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param s: Settings for the solver.
+/// \return The best task sequence found by the algorithm
+///         specified by an untrimmed Output.
+///
+Output DynasearchSolver::solve(int seed, Settings s) {
+    if (s.verbose) {
+        std::cout << "seed == " << seed << '\n';
+    }
+    std::vector<std::mt19937_64> gens(NUM_THREADS);
+    std::vector<std::thread> threads;
+    std::vector<Output> bestSequences(NUM_THREADS);
+    for (int tid = 0; tid < NUM_THREADS; ++tid) {
+        gens[tid].seed(seed + tid);
+        threads.emplace_back(std::thread(&DynasearchSolver::solveThread,
+                                         *this,
+                                         std::ref(bestSequences[tid]),
+                                         std::ref(gens[tid]),
+                                         s));
+    }
+    for (int tid = 0; tid < NUM_THREADS; ++tid) {
+        threads[tid].join();
+    }
+    return bestSequence(input, bestSequences);
+}
+
+///
+/// \brief Returns the name of the solver.
+/// \return Name of the solver.
+///
+std::string DynasearchSolver::name() const {
+    return "Dynasearch";
+}
+
+///
+/// \brief Searches on numThreads threads with the settings given at construction,
+///        restarting until the control asks to stop.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param numThreads: Number of threads to search on.
+/// \param control: Deadline and incumbent shared with other solvers.
+/// \return The best task sequence found by this solver.
+///
+Output DynasearchSolver::run(int seed, int numThreads, SolveControl &control) {
+    std::vector<std::mt19937_64> gens(numThreads);
+    std::vector<std::thread> threads;
+    std::vector<Output> bestSequences(numThreads);
+    for (int tid = 0; tid < numThreads; ++tid) {
+        gens[tid].seed(seed + tid);
+        threads.emplace_back(std::thread(&DynasearchSolver::runThread,
+                                         *this,
+                                         std::ref(bestSequences[tid]),
+                                         std::ref(gens[tid]),
+                                         std::ref(control)));
+    }
+    for (int tid = 0; tid < numThreads; ++tid) {
+        threads[tid].join();
+    }
+    return bestSequence(input, bestSequences);
+}
+
+///
+/// \brief Runs a single iterated dynasearch from a random sequence and assigns the
+///        best sequence found to bestSequence.
+/// \param bestSequence: Assigned to be the result upon completion.
+/// \param gen: Random generator.
+/// \param s: Settings for the solver.
+///
+void DynasearchSolver::solveThread(Output &bestSequence, std::mt19937_64 &gen, const Settings &s) {
+    FixedScheduleState state(input, randomSequence(input, gen));
+    search(state, bestSequence, gen, s);
+}
+
+///
+/// \brief Keeps searching until the control asks to stop. A restart begins from the
+///        shared incumbent if another thread or solver found a better sequence than
+///        this thread, and from a random sequence otherwise.
+/// \param bestSequence: Assigned to be the best sequence found by this thread.
+/// \param gen: Random generator.
+/// \param control: Deadline and incumbent shared with other solvers.
+///
+void DynasearchSolver::runThread(Output &bestSequence, std::mt19937_64 &gen, SolveControl &control) {
+    FixedScheduleState state(input, randomSequence(input, gen));
+    bestSequence = state.toOutput();
+    double maxProfit = state.getProfit();
+    Output currSequence;
+    while (!control.shouldStop()) {
+        double profit = search(state, currSequence, gen, settings, &control);
+        if (profit > maxProfit) {
+            maxProfit = profit;
+            bestSequence = currSequence;
+        }
+        control.offer(currSequence, profit);
+        if (control.getIncumbentProfit() > maxProfit && control.getIncumbent(currSequence, profit)) {
+            state.assign(currSequence.getSchedule());
+        } else {
+            state.assign(randomSequence(input, gen).getSchedule());
+        }
+    }
+}
+
+///
+/// \brief Runs a single iterated dynasearch from the given state. The current local
+///        optimum is replaced by the next one whenever that is no worse, so the search
+///        drifts across plateaus; it stops after maxNoImprove kicks without profit gain.
+/// \param state: Starting sequence, left at the current local optimum.
+/// \param bestSequence: Assigned to be the best sequence found.
+/// \param gen: Random generator.
+/// \param s: Settings for the solver.
+/// \param control: If specified, the search stops early when the control asks to stop,
+///        and improvements are offered to it as they are found.
+/// \return Profit of the best sequence found.
+///
+double DynasearchSolver::search(FixedScheduleState &state, Output &bestSequence, std::mt19937_64 &gen,
+                                const Settings &s, SolveControl *control) {
+    Dynasearch dynasearch(input, s.maxSpan);
+    dynasearch.descend(state);
+    bestSequence = state.toOutput();
+    double maxProfit = state.getProfit();
+    if (state.size() < 2) {
+        return maxProfit;
+    }
+
+    if (s.verbose) {
+        std::cout << "---------------- DYNASEARCH SOLVE BEGIN ----------------\n";
+        std::cout << "Printing Parameters... \n" << s;
+        std::cout << "Input size == " << state.size() << '\n';
+        std::cout << "Initial local optimum == " << maxProfit << '\n';
+    }
+
+    std::vector<int> current = state.getSequence();
+    FixedScheduleState::Value currValue = state.getValue();
+    int kicks = 0;
+    for (int idle = 0; idle < s.maxNoImprove && !(control && control->shouldStop()); ++kicks) {
+        kick(state, s.kickSwaps, gen);
+        dynasearch.descend(state);
+        if (state.getValue() >= currValue) {
+            current = state.getSequence();
+            currValue = state.getValue();
+        } else {
+            state.assign(current);
+        }
+
+        if (state.getProfit() - maxProfit >= PROFIT_GAIN_THRESH) {
+            idle = 0;
+        } else {
+            ++idle;
+        }
+        if (state.getProfit() > maxProfit) {
+            maxProfit = state.getProfit();
+            bestSequence = state.toOutput();
+            if (control && maxProfit > control->getIncumbentProfit()) {
+                control->offer(bestSequence, maxProfit);
+            }
+        }
+        if (s.verbose && kicks % s.printPeriod == 0) {
+            std::cout << "Kick " << kicks << ": current profit == " << state.getProfit()
+                      << ", best profit == " << maxProfit << '\n';
+        }
+    }
+    if (s.verbose) {
+        std::cout << "SEARCH IDLE, STOPPED AFTER " << kicks << " KICKS.\n";
+        std::cout << "Final profit == " << maxProfit << '\n';
+        std::cout << "---------------- DYNASEARCH SOLVE DONE ----------------\n";
+    }
+    return maxProfit;
+}
+
+///
+/// \brief Perturbs the sequence with random swaps, each with its first index inside the
+///        scheduled part of the sequence, since swaps entirely past the global deadline
+///        never change the profit.
+/// \param state: Sequence to perturb.
+/// \param swaps: Number of swaps.
+/// \param gen: Random generator.
+///
+void DynasearchSolver::kick(FixedScheduleState &state, int swaps, std::mt19937_64 &gen) const {
+    int n = state.size();
+    std::uniform_int_distribution<int> uniformTaskNumDist(0, n - 1);
+    for (int k = 0; k < swaps; ++k) {
+        int index1 = std::uniform_int_distribution<int>(0, std::min(state.cutoff(), n - 1))(gen);
+        int index2 = uniformTaskNumDist(gen);
+        while (index2 == index1) {
+            index2 = uniformTaskNumDist(gen);
+        }
+        state.applySwap(index1, index2);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef DYNASEARCHSOLVER_H
+#define DYNASEARCHSOLVER_H
+#include "dynasearch.h"
+#include "input.h"
+#include "output.h"
+#include "schedulestate.h"
+#include "solver.h"
+#include <random>
+
+///
+/// \brief Iterated dynasearch solver. Each thread descends to a local optimum of the
+///        Dynasearch neighbourhood, then repeatedly kicks it with a few random swaps and
+///        descends again, keeping the new local optimum if it is no worse. Every descent
+///        applies many independent moves per pass, so a thread reaches a local optimum in
+///        a few dozen passes instead of millions of random moves.
+///
+class DynasearchSolver : public Solver
+{
+public:
+    static const int NUM_THREADS = 8;
+    struct Settings {
+        int kickSwaps;          // Random swaps applied to the current local optimum before each descent.
+        int maxNoImprove;       // Number of kicks allowed with no profit gain.
+        int maxSpan;            // If positive, dynasearch moves span at most this many positions.
+        bool verbose;           // Prints all details if set to true. May not work properly if NUM_THREADS is more than 1.
+        int printPeriod;        // Print a summary every this number of kicks.
+
+        Settings(int kickSwaps = 3,
+                 int maxNoImprove = 500,
+                 int maxSpan = 0,
+                 bool verbose = false,
+                 int printPeriod = 100) {
+            this->kickSwaps = kickSwaps;
+            this->maxNoImprove = maxNoImprove;
+            this->maxSpan = maxSpan;
+            this->verbose = verbose;
+            this->printPeriod = printPeriod;
+        }
+
+        friend std::ostream& operator <<(std::ostream& out, const Settings& s) {
+            out << "GLOBAL NUM_THREADS == " << DynasearchSolver::NUM_THREADS << '\n';
+            out << "Kick swaps == " << s.kickSwaps << '\n';
+            out << "Max kicks with no profit gain == " << s.maxNoImprove << '\n';
+            if (s.maxSpan > 0) {
+                out << "Max move span == " << s.maxSpan << '\n';
+            }
+            return out;
+        }
+    };
+
+private:
+    Input input;
+    Settings settings;
+    const double PROFIT_GAIN_THRESH = 1e-3;     // No profit is considered gained if less than this value.
+
+public:
+    DynasearchSolver();
+    DynasearchSolver(const Input& in, const Settings& s = Settings());
+
+    Output solve(int seed = 0, Settings s = Settings());
+
+    std::string name() const override;
+    Output run(int seed, int numThreads, SolveControl& control) override;
+
+private:
+    void solveThread(Output& bestSequence, std::mt19937_64& gen, const Settings& s);
+    void runThread(Output& bestSequence, std::mt19937_64& gen, SolveControl& control);
+    double search(FixedScheduleState& state, Output& bestSequence, std::mt19937_64& gen,
+                  const Settings& s, SolveControl* control = nullptr);
+    void kick(FixedScheduleState& state, int swaps, std::mt19937_64& gen) const;
+};
+
+#endif // DYNASEARCHSOLVER_H
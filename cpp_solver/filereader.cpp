@@ -0,0 +1,244 @@
+#include "filereader.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+///
+/// \brief Maps or reads the file.
+/// \param fileName: Directory to the file.
+///
+FileBuffer::FileBuffer(const std::string &fileName) {
+#ifndef _WIN32
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        open = true;
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                begin = static_cast<const char*>(p);
+                mapped = true;
+            } else {
+                open = false;
+            }
+        }
+    }
+    ::close(fd);
+#else
+    std::FILE* file = std::fopen(fileName.c_str(), "rb");
+    if (!file) {
+        return;
+    }
+    open = true;
+    if (std::fseek(file, 0, SEEK_END) == 0) {
+        long fileSize = std::ftell(file);
+        if (fileSize > 0) {
+            storage.resize(static_cast<size_t>(fileSize));
+            std::rewind(file);
+            length = std::fread(storage.data(), 1, storage.size(), file);
+            begin = storage.data();
+        }
+    }
+    std::fclose(file);
+#endif
+}
+
+FileBuffer::~FileBuffer() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(begin), length);
+    }
+#endif
+}
+
+///
+/// \brief Returns whether the file could be opened.
+/// \return False if the file does not exist or cannot be read.
+///
+bool FileBuffer::isOpen() const {
+    return open;
+}
+
+///
+/// \brief Returns the content of the file, which is not null-terminated.
+/// \return Pointer to the first character, nullptr if the file is empty.
+///
+const char *FileBuffer::data() const {
+    return begin;
+}
+
+///
+/// \brief Returns the size of the file.
+/// \return Number of characters.
+///
+size_t FileBuffer::size() const {
+    return length;
+}
+
+///
+/// \brief Initializes a scanner at the beginning of a character range.
+/// \param begin: First character.
+/// \param length: Number of characters.
+/// \param name: Name of the source used in error positions, usually the file name.
+///
+TextScanner::TextScanner(const char *begin, size_t length, const std::string &name)
+    : pos(begin), end(begin + length), lineStart(begin), name(name) {}
+
+///
+/// \brief Returns whether only whitespace is left.
+/// \return True if there are no more tokens.
+///
+bool TextScanner::atEnd() {
+    skipSpace();
+    return pos == end;
+}
+
+///
+/// \brief Returns the number of characters not consumed yet, including whitespace.
+///
+size_t TextScanner::remaining() const {
+    return static_cast<size_t>(end - pos);
+}
+
+///
+/// \brief Reads a decimal integer with an optional sign.
+/// \param value: Assigned the integer if successful.
+/// \return False, without consuming anything, if the next token is not an integer
+///         that fits in an int.
+///
+bool TextScanner::readInt(int &value) {
+    skipSpace();
+    const char* p = pos;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    const char* digits = p;
+    long long result = 0;
+    while (p != end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p - '0');
+        if (result > 2147483648LL) {
+            return false;
+        }
+        ++p;
+    }
+    if (p == digits || !isDelimiter(p)) {
+        return false;
+    }
+    result = negative ? -result : result;
+    if (result > 2147483647LL) {
+        return false;
+    }
+    value = static_cast<int>(result);
+    pos = p;
+    return true;
+}
+
+///
+/// \brief Reads a decimal number of the form [sign]digits[.digits]. Numbers with up to
+///        15 significant digits are converted as mantissa / 10^decimals, where both
+///        operands are exact doubles, so the quotient is correctly rounded and thus
+///        equal to what strtod returns.
+/// \param value: Assigned the number if successful.
+/// \return False, without consuming anything, if the next token is not such a number.
+///
+bool TextScanner::readDecimal(double &value) {
+    static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                   1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+    skipSpace();
+    const char* p = pos;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    unsigned long long mantissa = 0;
+    int numDigits = 0;
+    int decimals = 0;
+    bool seenPoint = false;
+    for (; p != end; ++p) {
+        if (*p >= '0' && *p <= '9') {
+            if (numDigits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+            }
+            if (mantissa > 0) {
+                ++numDigits;
+            }
+            if (seenPoint) {
+                ++decimals;
+            }
+        } else if (*p == '.' && !seenPoint) {
+            seenPoint = true;
+        } else {
+            break;
+        }
+    }
+    const char* digitsBegin = pos + (pos != end && (*pos == '-' || *pos == '+'));
+    if (p == digitsBegin || (seenPoint && p == digitsBegin + 1) || !isDelimiter(p)) {
+        return false;
+    }
+    if (numDigits <= 15 && decimals <= 18) {
+        double result = static_cast<double>(mantissa);
+        if (decimals > 0) {
+            result /= POW10[decimals];
+        }
+        value = negative ? -result : result;
+    } else {
+        std::string token(pos, p);  // too long to convert exactly by hand
+        value = std::strtod(token.c_str(), nullptr);
+    }
+    pos = p;
+    return true;
+}
+
+///
+/// \brief Returns the position of the next token, to be formatted by where() only if needed.
+/// \return Line and column, both starting at 1.
+///
+TextScanner::Position TextScanner::position() {
+    skipSpace();
+    Position p = {line, static_cast<int>(pos - lineStart) + 1};
+    return p;
+}
+
+///
+/// \brief Returns the position of the next token for error messages.
+/// \return "name:line:column".
+///
+std::string TextScanner::where() {
+    return where(position());
+}
+
+///
+/// \brief Formats a position returned by position() for error messages.
+/// \param p: Position in the source.
+/// \return "name:line:column".
+///
+std::string TextScanner::where(const Position &p) const {
+    return name + ':' + std::to_string(p.line) + ':' + std::to_string(p.column);
+}
+
+void TextScanner::skipSpace() {
+    while (pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n')) {
+        if (*pos == '\n') {
+            ++line;
+            lineStart = pos + 1;
+        }
+        ++pos;
+    }
+}
+
+bool TextScanner::isDelimiter(const char *p) const {
+    return p == end || *p == ' ' || *p == '\t' || *p == '\r' || *p == '\n';
+}
@@ -0,0 +1,69 @@
+#ifndef FILEREADER_H
+#define FILEREADER_H
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///
+/// \brief Read-only view of the whole content of a file. On POSIX systems the file is
+///        memory-mapped, elsewhere it is read into memory with a single call, so either
+///        way the file is not copied token by token.
+///
+class FileBuffer
+{
+private:
+    const char* begin = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    bool open = false;
+    std::vector<char> storage;  // Holds the content when the file is not mapped.
+
+public:
+    FileBuffer(const std::string& fileName);
+    ~FileBuffer();
+
+    FileBuffer(const FileBuffer&) = delete;
+    FileBuffer& operator =(const FileBuffer&) = delete;
+
+    bool isOpen() const;
+    const char* data() const;
+    size_t size() const;
+};
+
+///
+/// \brief Single-pass scanner of whitespace-separated numbers in a character range,
+///        independent of the locale. It tracks the line and column of the next token
+///        so that errors can point at the exact position in the file.
+///
+class TextScanner
+{
+public:
+    struct Position {
+        int line;
+        int column;
+    };
+
+private:
+    const char* pos;
+    const char* end;
+    const char* lineStart;
+    int line = 1;
+    std::string name;
+
+public:
+    TextScanner(const char* begin, size_t length, const std::string& name);
+
+    bool atEnd();
+    size_t remaining() const;
+    bool readInt(int& value);
+    bool readDecimal(double& value);
+    Position position();
+    std::string where();
+    std::string where(const Position& p) const;
+
+private:
+    void skipSpace();
+    bool isDelimiter(const char* p) const;
+};
+
+#endif // FILEREADER_H
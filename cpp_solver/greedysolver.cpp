@@ -1,4 +1,6 @@
 #include "greedysolver.h"
+#include "batcheval.h"
+#include "profit.h"
 #include <cmath>
 #include <numeric>
 #include <algorithm>
@@ -14,62 +16,168 @@ GreedySolver::GreedySolver(const Input &in) {
 /// \return Schedule with max profit.
 ///
 Output GreedySolver::solve() {
+    std::vector<Output> outs;
+    outs.push_back(solveDeadline());
+    outs.push_back(solveDuration());
+    outs.push_back(solveLeastOverdue());
+    outs.push_back(solveMostProfitable());
+    outs.push_back(solveProfit());
+    outs.push_back(solveProfitRate());
+    std::vector<double> profits;
+    BatchEvaluator(input).evaluate(outs, profits);
+
     double maxProfit = 0.0;
     Output best;
-
-    Output out = solveDeadline();
-    double currProfit = out.evaluate(input);
-    if (currProfit > maxProfit) {
-        maxProfit = currProfit;
-        best = out;
+    for (size_t i = 0; i < outs.size(); ++i) {
+        if (profits[i] > maxProfit) {
+            maxProfit = profits[i];
+            best = outs[i];
+        }
     }
+    return best;
+}
 
-    out = solveDuration();
-    currProfit = out.evaluate(input);
-    if (currProfit > maxProfit) {
-        maxProfit = currProfit;
-        best = out;
-    }
+///
+/// \brief Returns the name of the solver.
+/// \return Name of the solver.
+///
+std::string GreedySolver::name() const {
+    return "Greedy";
+}
 
-    out = solveLeastOverdue();
-    currProfit = out.evaluate(input);
-    if (currProfit > maxProfit) {
-        maxProfit = currProfit;
-        best = out;
-    }
+///
+/// \brief Solves using all greedy algorithms once and offers the result.
+///        The greedy algorithms are deterministic and single-threaded, so
+///        seed and numThreads are ignored.
+/// \return Schedule with max profit.
+///
+Output GreedySolver::run(int, int, SolveControl &control) {
+    Output best = solve();
+    control.offer(best, best.evaluate(input));
+    return best;
+}
 
-    out = solveMostProfitable();
-    currProfit = out.evaluate(input);
-    if (currProfit > maxProfit) {
-        maxProfit = currProfit;
-        best = out;
+///
+/// \brief Keeps picking the task that causes the least number of remaining tasks to become
+///        overdue, the lowest index on ties. A task of duration d started at time makes
+///        every other remaining task with a deadline before time + d overdue, so all tasks
+///        of the same duration share that count, minus one for those that are themselves
+///        overdue. Remaining deadlines are counted with a Fenwick tree, and each group of
+///        tasks with the same duration keeps a min-tree of indices ordered by deadline.
+///        Counts grow with the duration, so each step scans durations in ascending order
+///        only until no group can beat the best one, taking O(n log n) time in total for
+///        the bounded range of durations.
+/// \return Schedule of all tasks.
+///
+Output GreedySolver::solveLeastOverdue() {
+    int n = input.size();
+    std::vector<int> byDeadline(n);
+    std::iota(byDeadline.begin(), byDeadline.end(), 0);
+    std::stable_sort(byDeadline.begin(), byDeadline.end(), Comparator<int>(input.getDeadlines()));
+    std::vector<int> sortedDeadlines(n);
+    std::vector<int> rank(n);
+    for (int k = 0; k < n; ++k) {
+        sortedDeadlines[k] = input.getDeadline(byDeadline[k]);
+        rank[byDeadline[k]] = k;
     }
-
-    out = solveProfit();
-    currProfit = out.evaluate(input);
-    if (currProfit > maxProfit) {
-        maxProfit = currProfit;
-        best = out;
+    std::vector<int> remaining(n + 1, 0);     // Fenwick tree over rank, 1 for each remaining task
+    for (int k = 1; k <= n; ++k) {
+        remaining[k] += 1;
+        if (k + (k & -k) <= n) {
+            remaining[k + (k & -k)] += remaining[k];
+        }
     }
+    auto countBefore = [&](int deadline) {  // remaining tasks with a deadline before the given time
+        int count = 0;
+        for (int k = static_cast<int>(std::lower_bound(sortedDeadlines.begin(), sortedDeadlines.end(), deadline)
+                                      - sortedDeadlines.begin()); k > 0; k -= k & -k) {
+            count += remaining[k];
+        }
+        return count;
+    };
 
-    out = solveProfitRate();
-    currProfit = out.evaluate(input);
-    if (currProfit > maxProfit) {
-        maxProfit = currProfit;
-        best = out;
+    // Group tasks by duration, each group ordered by deadline.
+    struct Group {
+        int duration;
+        int size;
+        std::vector<int> deadlines;     // deadlines of the group in ascending order
+        std::vector<int> minIndex;      // min-tree of task indices over deadline order, n if taken
+    };
+    std::vector<Group> groups;
+    std::vector<int> groupOf(n), slotOf(n);
+    std::vector<int> byDuration(byDeadline);
+    std::stable_sort(byDuration.begin(), byDuration.end(), Comparator<int>(input.getDurations()));
+    for (int task : byDuration) {
+        if (groups.empty() || groups.back().duration != input.getDuration(task)) {
+            groups.push_back(Group{input.getDuration(task), 0, std::vector<int>(), std::vector<int>()});
+        }
+        groupOf[task] = static_cast<int>(groups.size()) - 1;
+        slotOf[task] = groups.back().size++;
+        groups.back().deadlines.push_back(input.getDeadline(task));
     }
-    return best;
-}
+    for (Group& g : groups) {
+        g.minIndex.assign(2 * g.size, n);
+    }
+    for (int task = 0; task < n; ++task) {
+        Group& g = groups[groupOf[task]];
+        g.minIndex[g.size + slotOf[task]] = task;
+    }
+    for (Group& g : groups) {
+        for (int k = g.size - 1; k > 0; --k) {
+            g.minIndex[k] = std::min(g.minIndex[2 * k], g.minIndex[2 * k + 1]);
+        }
+    }
+    auto minIndexBefore = [n](const Group& g, int end) {   // lowest remaining index among slots [0, end)
+        int res = n;
+        for (int lo = g.size, hi = g.size + end; lo < hi; lo >>= 1, hi >>= 1) {
+            if (lo & 1) {
+                res = std::min(res, g.minIndex[lo++]);
+            }
+            if (hi & 1) {
+                res = std::min(res, g.minIndex[--hi]);
+            }
+        }
+        return res;
+    };
 
-Output GreedySolver::solveLeastOverdue() {
-    resetTaken();
-    // keep picking the task that causes least number of tasks to become overdue
     int time = 0;
-    std::vector<int> sequence(input.size());
-    for (int i = 0; i < input.size(); ++i) {
-        sequence[i] = leastOverdueIndex(time);
-        time += input.getDuration(sequence[i]);
-        input.setTaken(sequence[i]);
+    std::vector<int> sequence(n);
+    for (int i = 0; i < n; ++i) {
+        long long bestKey = -1;     // overdue count * (n + 1) + task index
+        int best = -1;
+        for (const Group& g : groups) {
+            if (g.minIndex[1] == n) {
+                continue;   // every task of the group is taken
+            }
+            int finishTime = time + g.duration;
+            int count = countBefore(finishTime);
+            if (best >= 0 && count - 1 > bestKey / (n + 1)) {
+                break;
+            }
+            int end = static_cast<int>(std::lower_bound(g.deadlines.begin(), g.deadlines.end(), finishTime)
+                                       - g.deadlines.begin());
+            int task = minIndexBefore(g, end);  // overdue itself, so it does not count
+            if (task < n) {
+                --count;
+            } else {
+                task = minIndexBefore(g, g.size);
+            }
+            long long key = static_cast<long long>(count) * (n + 1) + task;
+            if (task < n && (best < 0 || key < bestKey)) {
+                bestKey = key;
+                best = task;
+            }
+        }
+        sequence[i] = best;
+        time += input.getDuration(best);
+        for (int k = rank[best] + 1; k <= n; k += k & -k) {
+            remaining[k] -= 1;
+        }
+        Group& g = groups[groupOf[best]];
+        int k = g.size + slotOf[best];
+        for (g.minIndex[k] = n; k > 1; k >>= 1) {
+            g.minIndex[k >> 1] = std::min(g.minIndex[k], g.minIndex[k ^ 1]);
+        }
     }
     return Output(sequence);
 }
@@ -133,7 +241,7 @@ int GreedySolver::maxProfitIndex(int time) const {
         }
         int overtime = time + input.getDuration(i) - input.getDeadline(i);
         if (overtime > 0) {
-            profit = input.getProfit(i) * exp(-0.017 * overtime);
+            profit = input.getProfit(i) * FloatingProfit::latePenalty(overtime);
         } else {
             profit = input.getProfit(i);
         }
@@ -145,31 +253,6 @@ int GreedySolver::maxProfitIndex(int time) const {
     return index;
 }
 
-int GreedySolver::leastOverdueIndex(int time) const {
-    int overdueCount;
-    int minOverdueCount = -1;
-    int res = -1;
-    for (int i = 0; i < input.size(); ++i) {
-        overdueCount = 0;
-        if (input.isTaken(i)) {
-            continue;
-        }
-        int finishTime = time + input.getDuration(i);
-        for (int j = 0; j < input.size(); ++j) {
-            if (i == j || input.isTaken(j)) {
-                continue;
-            } else if (finishTime > input.getDeadline(j)) {
-                ++overdueCount;
-            }
-        }
-        if (overdueCount < minOverdueCount || minOverdueCount == -1) {
-            minOverdueCount = overdueCount;
-            res = i;
-        }
-    }
-    return res;
-}
-
 void GreedySolver::resetTaken() {
     for (int i = 0; i < input.size(); ++i) {
         input.setTaken(i, false);
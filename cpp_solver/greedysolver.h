@@ -2,8 +2,9 @@
 #define GREEDYSOLVER_H
 #include "input.h"
 #include "output.h"
+#include "solver.h"
 
-class GreedySolver
+class GreedySolver : public Solver
 {
 private:
     Input input;
@@ -13,6 +14,9 @@ public:
     GreedySolver(const Input& in);
 
     Output solve();
+
+    std::string name() const override;
+    Output run(int seed, int numThreads, SolveControl& control) override;
     Output solveLeastOverdue();
     Output solveMostProfitable();
     Output solveDeadline();
@@ -31,7 +35,6 @@ private:
     };
 
     int maxProfitIndex(int time) const;
-    int leastOverdueIndex(int time) const;
     void resetTaken();
 };
 
@@ -0,0 +1,26 @@
+#ifndef HASH_H
+#define HASH_H
+#include <cstddef>
+#include <cstdint>
+
+const uint64_t HASH_SEED = 14695981039346656037ULL;   // FNV-1a 64-bit offset basis.
+
+///
+/// \brief 64-bit FNV-1a hash of a byte range. Passing the result of a previous call
+///        as seed hashes the concatenation of the ranges.
+/// \param data: First byte.
+/// \param size: Number of bytes.
+/// \param seed: HASH_SEED, or the hash of the preceding bytes.
+/// \return Hash of the bytes.
+///
+inline uint64_t hashBytes(const void* data, size_t size, uint64_t seed = HASH_SEED) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed;
+    for (size_t k = 0; k < size; ++k) {
+        h ^= p[k];
+        h *= 1099511628211ULL;  // FNV-1a 64-bit prime
+    }
+    return h;
+}
+
+#endif // HASH_H
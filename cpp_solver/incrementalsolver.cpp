@@ -0,0 +1,141 @@
+#include "incrementalsolver.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+///
+/// \brief Initializes a solver instance using the new Input.
+/// \param in: Problem is specified by this Input.
+///
+IncrementalSolver::IncrementalSolver(const Input &in) : input(in) {}
+
+///
+/// \brief Repairs the Output of the old Input and anneals from it at a low temperature.
+/// \param oldInput: Input that oldOutput was solved for.
+/// \param oldOutput: Best known Output of oldInput, trimmed or untrimmed.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param s: settings for the solver.
+/// \return The best task sequence found for the new Input specified by an untrimmed Output.
+///
+Output IncrementalSolver::solve(const Input &oldInput, const Output &oldOutput, int seed, Settings s) {
+    LocalSearch ls(input);
+    FixedScheduleState best(input, repair(oldInput, oldOutput));
+    ls.descend(best);
+    SASolver sas(input);
+    FixedScheduleState annealed(input, sas.solveFrom(best.toOutput(), seed,
+                                                     SASolver::Settings(0, s.alpha, s.maxRejections, s.epochSizeFactor,
+                                                                        s.initAccRate, false, 1, true)));
+    ls.descend(annealed);
+    return annealed.getValue() > best.getValue() ? annealed.toOutput() : best.toOutput();
+}
+
+///
+/// \brief Carries the Output of the old Input over to the new Input. Matched tasks keep
+///        their relative order and removed tasks are dropped. Each added task, most
+///        profitable per minute first, is then moved to the position within the global
+///        deadline that gains the most, if any position gains at all.
+/// \param oldInput: Input that oldOutput was solved for.
+/// \param oldOutput: Best known Output of oldInput, trimmed or untrimmed.
+/// \return Untrimmed Output for the new Input.
+///
+Output IncrementalSolver::repair(const Input &oldInput, const Output &oldOutput) const {
+    std::vector<int> match = matchTasks(oldInput, input);
+    std::vector<bool> added(input.size(), true);
+    std::vector<int> schedule;
+    for (int task = 0; task < oldInput.size(); ++task) {
+        if (match[task] >= 0) {
+            added[match[task]] = false;
+        }
+    }
+    for (int task : oldOutput.getSchedule()) {
+        if (task >= 0 && task < oldInput.size() && match[task] >= 0) {
+            schedule.push_back(match[task]);
+        }
+    }
+
+    std::vector<int> order;
+    for (int task = 0; task < input.size(); ++task) {
+        if (added[task]) {
+            order.push_back(task);
+        }
+    }
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return input.getProfit(a) * input.getDuration(b) > input.getProfit(b) * input.getDuration(a);
+    });
+
+    // Added tasks are appended after the scheduled ones, then inserted one by one.
+    FixedScheduleState state(input, Output(schedule));
+    std::vector<int> position(input.size());
+    for (int task : order) {
+        for (int k = 0; k < state.size(); ++k) {
+            position[state.taskAt(k)] = k;
+        }
+        int from = position[task];
+        int bestTo = from;
+        FixedScheduleState::Value bestDelta = 0;
+        for (int to = std::min(from, state.cutoff()); to >= 0; --to) {
+            FixedScheduleState::Value delta = state.insertDelta(from, to);
+            if (delta > bestDelta) {
+                bestDelta = delta;
+                bestTo = to;
+            }
+        }
+        state.applyInsert(from, bestTo);
+    }
+    return state.toOutput();
+}
+
+///
+/// \brief Matches the tasks of two Inputs. Tasks have no identity other than their index
+///        and attributes, and indices may shift when tasks are added or removed, so a task
+///        is first matched to a task with the same deadline, duration, and profit, at the
+///        same index if possible. Unmatched tasks at the same index in both Inputs are
+///        then taken to be the same task with changed attributes.
+/// \param oldInput: Previous Input.
+/// \param newInput: Current Input.
+/// \return match[i] == index in newInput of task i of oldInput, -1 if it was removed.
+///
+std::vector<int> IncrementalSolver::matchTasks(const Input &oldInput, const Input &newInput) {
+    typedef std::tuple<int, int, int> Key;
+    std::vector<int> match(oldInput.size(), -1);
+    std::vector<bool> taken(newInput.size(), false);
+    std::map<Key, std::vector<int>> byKey;     // new tasks with each key, in decreasing index order
+    for (int task = newInput.size() - 1; task >= 0; --task) {
+        byKey[Key(newInput.getDeadline(task), newInput.getDuration(task), newInput.getScaledProfit(task))].push_back(task);
+    }
+    auto keyOf = [](const Input& in, int task) {
+        return Key(in.getDeadline(task), in.getDuration(task), in.getScaledProfit(task));
+    };
+
+    for (int task = 0; task < oldInput.size() && task < newInput.size(); ++task) {
+        if (keyOf(oldInput, task) == keyOf(newInput, task)) {
+            match[task] = task;
+            taken[task] = true;
+        }
+    }
+    for (int task = 0; task < oldInput.size(); ++task) {
+        if (match[task] >= 0) {
+            continue;
+        }
+        std::map<Key, std::vector<int>>::iterator it = byKey.find(keyOf(oldInput, task));
+        if (it == byKey.end()) {
+            continue;
+        }
+        std::vector<int>& candidates = it->second;
+        while (!candidates.empty() && taken[candidates.back()]) {
+            candidates.pop_back();
+        }
+        if (!candidates.empty()) {
+            match[task] = candidates.back();
+            taken[candidates.back()] = true;
+            candidates.pop_back();
+        }
+    }
+    for (int task = 0; task < oldInput.size() && task < newInput.size(); ++task) {
+        if (match[task] < 0 && !taken[task]) {
+            match[task] = task;
+            taken[task] = true;
+        }
+    }
+    return match;
+}
@@ -0,0 +1,59 @@
+#ifndef INCREMENTALSOLVER_H
+#define INCREMENTALSOLVER_H
+#include "input.h"
+#include "output.h"
+#include "localsearch.h"
+#include "sasolver.h"
+#include <vector>
+
+///
+/// \brief Re-solves an Input that differs slightly from one solved before, e.g. by a few
+///        added, removed, or re-prioritized tasks. The previous Output is repaired instead of
+///        annealing from a random sequence: tasks are matched between the two Inputs by their
+///        attributes, removed tasks are dropped, and added tasks are inserted greedily where
+///        they gain the most. The repaired sequence is polished by LocalSearch, then by a
+///        short SA at a low temperature followed by local search again, and the better of the
+///        two is returned, so the result stays close to the repaired sequence and is never
+///        worse than it.
+///
+class IncrementalSolver
+{
+public:
+    struct Settings {
+        double alpha;           // Rate of temperature decay.
+        int maxRejections;      // Maximum number of epochs to be rejected before the system is deemed frozen.
+        double epochSizeFactor; // Number of perturbations in each epoch == epochSizeFactor * numTasks * numTasks.
+        double initAccRate;     // Initial acceptance rate for downhill movements, low to stay near the repaired sequence.
+
+        Settings(double alpha = 0.9,
+                 int maxRejections = 5,
+                 double epochSizeFactor = 0.25,
+                 double initAccRate = 0.05) {
+            this->alpha = alpha;
+            this->maxRejections = maxRejections;
+            this->epochSizeFactor = epochSizeFactor;
+            this->initAccRate = initAccRate;
+        }
+
+        friend std::ostream& operator <<(std::ostream& out, const Settings& s) {
+            out << "Incremental temperature decay factor == " << s.alpha << '\n';
+            out << "Incremental initial acceptance rate == " << s.initAccRate << '\n';
+            out << "Incremental epoch size factor == " << s.epochSizeFactor << '\n';
+            out << "Incremental max epochs with no profit gain == " << s.maxRejections << '\n';
+            return out;
+        }
+    };
+
+private:
+    Input input;
+
+public:
+    IncrementalSolver(const Input& in);
+
+    Output solve(const Input& oldInput, const Output& oldOutput, int seed = 0, Settings s = Settings());
+    Output repair(const Input& oldInput, const Output& oldOutput) const;
+
+    static std::vector<int> matchTasks(const Input& oldInput, const Input& newInput);
+};
+
+#endif // INCREMENTALSOLVER_H
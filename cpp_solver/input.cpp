@@ -1,7 +1,10 @@
 #include "input.h"
+#include "filereader.h"
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <cmath>
 
 Input::Input() {}
 
@@ -9,59 +12,185 @@ Input::Input() {}
 /// \brief Generates a random Input with the number of tasks specified.
 /// \param numTasks: number of tasks to include.
 /// \param seed: seed for the pseudo-random number generator.
+/// \param horizon: Global deadline, deadlines are drawn up to it.
 ///
-Input::Input(int numTasks, int seed) {
+Input::Input(int numTasks, int seed, int horizon) : horizon(horizon) {
     if (numTasks <= 0) {
         return;
     }
     n = numTasks;
     gen.seed(seed);
     for (int i = 0; i < n; ++i) {
-        deadlines.push_back(static_cast<int>(uniformRealDist(gen) * std::min(n * 20, MAX_TIME) + 1));
+        deadlines.push_back(static_cast<int>(uniformRealDist(gen) * std::min(20.0 * n, static_cast<double>(horizon)) + 1));
         durations.push_back(static_cast<int>(uniformRealDist(gen) * DURATION_MAX + 1));
         profits.push_back(round(uniformRealDist(gen) * PROFIT_MAX_EXCLUSIVE * 1000.0) / 1000.0);
     }
     taken = std::vector<bool>(n, false);
+    valid = true;
+    for (int i = 0; i < n; ++i) {
+        if (!validateTask(deadlines[i], durations[i], profits[i])) {
+            valid = false;
+        }
+    }
+    scaleProfits();
 }
 
 ///
-/// \brief Reads an Input from a file.
+/// \brief Initializes an Input from the attributes of its tasks, validating every task.
+/// \param deadlines: Deadline of each task.
+/// \param durations: Duration of each task.
+/// \param profits: Profit of each task.
+/// \param horizon: Global deadline.
+///
+Input::Input(const std::vector<int> &deadlines, const std::vector<int> &durations, const std::vector<double> &profits,
+             int horizon)
+    : n(static_cast<int>(deadlines.size())), horizon(horizon), deadlines(deadlines), durations(durations),
+      profits(profits) {
+    taken = std::vector<bool>(n, false);
+    valid = true;
+    for (int i = 0; i < n; ++i) {
+        if (!validateTask(deadlines[i], durations[i], profits[i])) {
+            valid = false;
+        }
+    }
+    scaleProfits();
+}
+
+///
+/// \brief Reads an Input from a file in a single pass, validating every task as it is read.
+///        If the file cannot be opened or is malformed, failed() returns true and
+///        getError() tells where reading stopped.
 /// \param fileName: Directory to the file.
 /// \param preset: Task number preset. If specified to 100, 150, or 200,
-///        the constructor will also check for validity of the input.
-///        If not specified, the Input is by default valid.
+///        the constructor will also check for validity of the number of tasks.
+///        Any number of tasks is accepted if zero.
+/// \param horizon: Global deadline.
 ///
-Input::Input(const std::string& fileName, int preset) {
-    std::fstream fs(fileName, std::fstream::in);
+Input::Input(const std::string& fileName, int preset, int horizon) : horizon(horizon) {
+    FileBuffer file(fileName);
 
     // Terminate if file does not exist.
-    if (!fs.good()) {
+    if (!file.isOpen()) {
         fail = true;
+        error = fileName + ": cannot open file";
+        return;
+    }
+    read(file.data(), file.size(), fileName, preset);
+}
+
+///
+/// \brief Reads an Input from text in the format of an input file, such as an Input
+///        received over a pipe or a socket. Errors are reported like the file constructor.
+/// \param text: Content of an input file.
+/// \param name: Name of the text in error messages.
+/// \param preset: Task number preset, see the file constructor.
+/// \param horizon: Global deadline.
+/// \return The Input read.
+///
+Input Input::fromText(const std::string &text, const std::string &name, int preset, int horizon) {
+    Input in;
+    in.horizon = horizon;
+    in.read(text.data(), text.size(), name, preset);
+    return in;
+}
+
+///
+/// \brief Reads the tasks of the Input in a single pass, see the file constructor.
+/// \param data: Content of an input file.
+/// \param length: Number of characters in data.
+/// \param name: Name of the content in error messages.
+/// \param preset: Task number preset, zero to accept any number of tasks.
+///
+void Input::read(const char *data, size_t length, const std::string &name, int preset) {
+    TextScanner scanner(data, length, name);
+    if (!scanner.readInt(n) || n < 0) {
+        fail = true;
+        error = scanner.where() + ": expected the number of tasks";
+        n = 0;
+        return;
+    }
+    // A task takes at least 8 characters, a separator and four numbers with three
+    // separators between them, so a count the text cannot hold is rejected before
+    // anything of that size is allocated.
+    if (static_cast<size_t>(n) > scanner.remaining() / 8) {
+        fail = true;
+        error = scanner.where() + ": " + std::to_string(n) + " tasks do not fit in the rest of the text";
+        n = 0;
         return;
     }
-    fs >> n;
     deadlines = std::vector<int>(n, 0);
     durations = std::vector<int>(n, 0);
     profits = std::vector<double>(n, 0);
     taken = std::vector<bool>(n, false);
     valid = true;
-    if (preset > 0) {
-        valid = validateTaskNumber(n, preset);
+    std::string reason;
+    if (preset > 0 && !validateTaskNumber(n, preset, &reason)) {
+        error = name + ": " + reason;
+        valid = false;
     }
     int taskIndex;
     for (int i = 0; i < n; ++i) {
-        fs >> taskIndex >> deadlines[i] >> durations[i] >> profits[i];
-        valid = taskIndex == i + 1 && validateTask(deadlines[i], durations[i], profits[i]);
+        // Tasks that cannot be read fail the Input; tasks that violate the spec only make it invalid.
+        TextScanner::Position taskPosition = scanner.position();
+        std::string readError;
+        if (!scanner.readInt(taskIndex)) {
+            readError = scanner.where() + ": expected the index of task " + std::to_string(i + 1);
+        } else if (!scanner.readInt(deadlines[i])) {
+            readError = scanner.where() + ": expected the deadline of task " + std::to_string(i + 1);
+        } else if (!scanner.readInt(durations[i])) {
+            readError = scanner.where() + ": expected the duration of task " + std::to_string(i + 1);
+        } else if (!scanner.readDecimal(profits[i])) {
+            readError = scanner.where() + ": expected the profit of task " + std::to_string(i + 1);
+        }
+        if (!readError.empty()) {
+            fail = true;
+            valid = false;
+            error = readError;
+            return;
+        }
+        if (taskIndex != i + 1) {
+            if (valid) {
+                error = scanner.where(taskPosition) + ": task index " + std::to_string(taskIndex)
+                        + " should be " + std::to_string(i + 1);
+            }
+            valid = false;
+        } else if (!validateTask(deadlines[i], durations[i], profits[i], &reason)) {
+            if (valid) {
+                error = scanner.where(taskPosition) + ": task " + std::to_string(i + 1) + " violates the project spec: "
+                        + reason;
+            }
+            valid = false;
+        }
     }
-    fs.close();
+    if (!scanner.atEnd()) {
+        if (valid) {
+            error = scanner.where() + ": unexpected content after the last task";
+        }
+        valid = false;
+    }
+    scaleProfits();
 }
 
+///
+/// \brief Returns whether reading the Input failed, in which case it has no usable tasks.
+///        An Input that did not fail may still violate the spec, see isValid().
+/// \return True if the file could not be opened or its tasks could not be read.
+///
 bool Input::failed() const {
     return fail;
 }
 
 ///
-/// \brief Returns if the Input is valid.
+/// \brief Returns the first problem found while reading the Input from a file.
+/// \return "file:line:column: message", empty if there was no problem.
+///
+const std::string &Input::getError() const {
+    return error;
+}
+
+///
+/// \brief Returns if the Input is valid, that is, it did not fail and every task follows
+///        the project spec. Solvers may only be given valid Inputs.
 /// \return true if the Input is valid, false otherwise.
 ///
 bool Input::isValid() const {
@@ -76,6 +205,14 @@ int Input::size() const {
     return n;
 }
 
+///
+/// \brief Returns the global deadline, after which tasks earn nothing.
+/// \return MAX_TIME unless specified otherwise at construction.
+///
+int Input::getHorizon() const {
+    return horizon;
+}
+
 ///
 /// \brief Returns the deadline of task i.
 /// \param i: index of a task.
@@ -103,6 +240,16 @@ double Input::getProfit(int i) const {
     return profits[i];
 }
 
+///
+/// \brief Returns the profit of task i multiplied by PROFIT_SCALE, which is exact
+///        since profits have at most three decimals.
+/// \param i: index of a task.
+/// \return Scaled profit of task i.
+///
+int Input::getScaledProfit(int i) const {
+    return scaledProfits[i];
+}
+
 ///
 /// \brief Returns whether the task has been taken.
 /// \param i: index of a task.
@@ -160,39 +307,48 @@ void Input::writeFile(const std::string &fileName) const {
     fs.close();
 }
 
+namespace {
+
+///
+/// \brief Describes a value out of range for validation messages.
+/// \param reason: Assigned "invalid <what> <value> is <relation> than <bound>" if not null.
+/// \return False, for the validation to return.
+///
+template <class Value, class Bound>
+bool reject(std::string* reason, const char* what, Value value, const char* relation, Bound bound) {
+    if (reason) {
+        std::ostringstream ss;
+        ss << "invalid " << what << ' ' << value << " is " << relation << " than " << bound;
+        *reason = ss.str();
+    }
+    return false;
+}
+
+}
+
 ///
 /// \brief Validates a task by checking the validity of its deadline, duration,
-///        and profit against the project spec.
+///        and profit against the project spec. Deadlines may be as late as the
+///        horizon if it was set beyond DEADLINE_MAX.
 /// \param deadline: Deadline of the task
 /// \param duration: Duration of the task
 /// \param profit: Profit of the task.
+/// \param reason: If not null, assigned what is wrong with an invalid task.
 /// \return True if the parameters are valid, false otherwise.
 ///
-bool Input::validateTask(int deadline, int duration, double profit) const {
+bool Input::validateTask(int deadline, int duration, double profit, std::string* reason) const {
     if (deadline < DEADLINE_MIN) {
-        std::cout << "Input::validateTask(): invalid deadline " << deadline
-                  << " is smaller than " << DEADLINE_MIN << "!\n";
-        return false;
-    } else if (deadline > DEADLINE_MAX) {
-        std::cout << "Input::validateTask(): invalid deadline " << deadline
-                  << " is greater than " << DEADLINE_MAX << "!\n";
-        return false;
+        return reject(reason, "deadline", deadline, "smaller", DEADLINE_MIN);
+    } else if (deadline > std::max(DEADLINE_MAX, horizon)) {
+        return reject(reason, "deadline", deadline, "greater", std::max(DEADLINE_MAX, horizon));
     } else if (duration < DURATION_MIN) {
-        std::cout << "Input::validateTask(): invalid duration " << duration
-                  << " is smaller than " << DURATION_MIN << "!\n";
-        return false;
+        return reject(reason, "duration", duration, "smaller", DURATION_MIN);
     } else if (duration > DURATION_MAX) {
-        std::cout << "Input::validateTask(): invalid duration " << duration
-                  << " is greater than " << DURATION_MAX << "!\n";
-        return false;
+        return reject(reason, "duration", duration, "greater", DURATION_MAX);
     } else if (profit <= PROFIT_MIN_EXCLUSIVE) {
-        std::cout << "Input::validateTask(): invalid profit " << profit
-                  << " is smaller than " << PROFIT_MIN_EXCLUSIVE << "!\n";
-        return false;
+        return reject(reason, "profit", profit, "not greater", PROFIT_MIN_EXCLUSIVE);
     } else if (profit >= PROFIT_MAX_EXCLUSIVE) {
-        std::cout << "Input::validateTask(): invalid profit " << profit
-                  << " is greater than " << PROFIT_MAX_EXCLUSIVE << "!\n";
-        return false;
+        return reject(reason, "profit", profit, "not smaller", PROFIT_MAX_EXCLUSIVE);
     } else {
         return true;
     }
@@ -202,57 +358,36 @@ bool Input::validateTask(int deadline, int duration, double profit) const {
 /// \brief Checks the validity of the number of tasks.
 /// \param n: Number of tasks.
 /// \param preset: 100, 150, or 200, as specified by project.
+/// \param reason: If not null, assigned what is wrong with an invalid number.
 /// \return True if valid, false otherwise.
 ///
-bool Input::validateTaskNumber(int n, int preset) const {
+bool Input::validateTaskNumber(int n, int preset, std::string* reason) const {
+    int minTasks, maxTasks;
     switch (preset) {
     case 100:
-        if (n < TASKS_100_MIN) {
-            std::cout << "Input::validateTaskNumber(): invalid task number " << n
-                      << " is smaller than " << TASKS_100_MIN << "!\n";
-            return false;
-        } else if (n > TASKS_100_MAX) {
-            std::cout << "Input::validateTaskNumber(): invalid task number " << n
-                      << " is greater than " << TASKS_100_MAX << "!\n";
-            return false;
-        } else {
-            return true;
-        }
+        minTasks = TASKS_100_MIN;
+        maxTasks = TASKS_100_MAX;
         break;
-
     case 150:
-        if (n < TASKS_150_MIN) {
-            std::cout << "Input::validateTaskNumber(): invalid task number " << n
-                      << " is smaller than " << TASKS_150_MIN << "!\n";
-            return false;
-        } else if (n > TASKS_150_MAX) {
-            std::cout << "Input::validateTaskNumber(): invalid task number " << n
-                      << " is greater than " << TASKS_150_MAX << "!\n";
-            return false;
-        } else {
-            return true;
-        }
+        minTasks = TASKS_150_MIN;
+        maxTasks = TASKS_150_MAX;
         break;
-
     case 200:
-        if (n < TASKS_200_MIN) {
-            std::cout << "Input::validateTaskNumber(): invalid task number " << n
-                      << " is smaller than " << TASKS_200_MIN << "!\n";
-            return false;
-        } else if (n > TASKS_200_MAX) {
-            std::cout << "Input::validateTaskNumber(): invalid task number " << n
-                      << " is greater than " << TASKS_200_MAX << "!\n";
-            return false;
-        } else {
-            return true;
-        }
+        minTasks = TASKS_200_MIN;
+        maxTasks = TASKS_200_MAX;
         break;
-
     default:
-        std::cout << "Input::validateTaskNumber(): invalid preset == " << preset << '\n';
+        if (reason) {
+            *reason = "invalid preset " + std::to_string(preset);
+        }
         return false;
-        break;
     }
+    if (n < minTasks) {
+        return reject(reason, "task number", n, "smaller", minTasks);
+    } else if (n > maxTasks) {
+        return reject(reason, "task number", n, "greater", maxTasks);
+    }
+    return true;
 }
 
 ///
@@ -275,3 +410,12 @@ std::ostream& operator <<(std::ostream &o, const Input& in) {
     return o;
 }
 
+///
+/// \brief Fills scaledProfits from profits.
+///
+void Input::scaleProfits() {
+    scaledProfits.resize(profits.size());
+    for (size_t i = 0; i < profits.size(); ++i) {
+        scaledProfits[i] = static_cast<int>(llround(profits[i] * PROFIT_SCALE));
+    }
+}
@@ -11,45 +11,62 @@ const int TASKS_150_MIN = 101;
 const int TASKS_150_MAX = 150;
 const int TASKS_200_MIN = 151;
 const int TASKS_200_MAX = 200;
-const int MAX_TIME = 1440;
+const int MAX_TIME = 1440;              // Global deadline (horizon) of the project instances.
 const int DEADLINE_MIN = 1;
 const int DEADLINE_MAX = 1440;
 const int DURATION_MIN = 1;
 const int DURATION_MAX = 60;
 const double PROFIT_MIN_EXCLUSIVE = 0.0;
 const double PROFIT_MAX_EXCLUSIVE = 100.0;
+const int PROFIT_SCALE = 1000;          // Profits have at most three decimals, so PROFIT_SCALE * profit is an integer.
+const double LATE_DECAY_RATE = 0.017;   // Profit of a late task is multiplied by exp(-LATE_DECAY_RATE * minutesLate).
 
 ///
 /// \brief An Input object is a problem instance specified by number of tasks together with deadline,
 ///  duration, and profit of each task. An Input can be read from a file on disk, or randomly generated
-///  by specifying the number of tasks.
+///  by specifying the number of tasks. Tasks finishing after the horizon earn nothing; the horizon is
+///  MAX_TIME for the project instances, and can be set to any value for larger instances, in which
+///  case deadlines are checked against it instead of DEADLINE_MAX.
+///  An Input read from text has failed() if its tasks could not be read at all, and is otherwise
+///  complete; isValid() further tells whether every task follows the project spec. Solvers and
+///  their specializations assume isValid(), so callers that accept untrusted text, such as the
+///  service and the streaming pipeline, must reject Inputs that are not valid.
 ///
 class Input
 {
 private:
-    int n;
+    int n = 0;
+    int horizon = MAX_TIME;
     std::vector<int> deadlines;
     std::vector<int> durations;
     std::vector<double> profits;
+    std::vector<int> scaledProfits;
     std::vector<bool> taken;
-    bool valid;
+    bool valid = false;
     bool fail = false;
+    std::string error;
 
     std::mt19937_64 gen;
     std::uniform_real_distribution<> uniformRealDist = std::uniform_real_distribution<double>(0.0, 1.0);
 
 public:
     Input();
-    Input(int numTasks, int seed = 0);
-    Input(const std::string &fileName, int preset = 0);
+    Input(int numTasks, int seed = 0, int horizon = MAX_TIME);
+    Input(const std::string &fileName, int preset = 0, int horizon = MAX_TIME);
+    Input(const std::vector<int>& deadlines, const std::vector<int>& durations, const std::vector<double>& profits,
+          int horizon = MAX_TIME);
+    static Input fromText(const std::string& text, const std::string& name, int preset = 0, int horizon = MAX_TIME);
 
     bool failed() const;
+    const std::string& getError() const;
     bool isValid() const;
 
     int size() const;
+    int getHorizon() const;
     int getDeadline(int i) const;
     int getDuration(int i) const;
     double getProfit(int i) const;
+    int getScaledProfit(int i) const;
     bool isTaken(int i) const;
     void setTaken(int i, bool val = true);
 
@@ -61,8 +78,10 @@ public:
     friend std::ostream& operator <<(std::ostream& o, const Input& in);
 
 private:
-    bool validateTask(int deadline, int duration, double profit) const;
-    bool validateTaskNumber(int n, int preset) const;
+    void read(const char* data, size_t length, const std::string& name, int preset);
+    bool validateTask(int deadline, int duration, double profit, std::string* reason = nullptr) const;
+    bool validateTaskNumber(int n, int preset, std::string* reason = nullptr) const;
+    void scaleProfits();
 };
 
 #endif // INPUT_H
@@ -0,0 +1,204 @@
+#include "lahcsolver.h"
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+LAHCSolver::LAHCSolver() {}
+
+///
+/// \brief Initializes a solver instance using the Input.
+/// \param in: Problem is specified by this Input.
+/// \param s: Settings used by run().
+///
+LAHCSolver::LAHCSolver(const Input &in, const Settings &s) {
+    input = in;
+    settings = s;
+}
+
+///
+/// \brief Solves the problem with the seed and settings specified.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param s: Settings for the solver.
+/// \return The best task sequence found by the algorithm
+///         specified by an untrimmed Output.
+///
+Output LAHCSolver::solve(int seed, Settings s) {
+    if (s.verbose) {
+        std::cout << "seed == " << seed << '\n';
+    }
+    std::vector<std::mt19937_64> gens(NUM_THREADS);
+    std::vector<std::thread> threads;
+    std::vector<Output> bestSequences(NUM_THREADS);
+    for (int tid = 0; tid < NUM_THREADS; ++tid) {
+        gens[tid].seed(seed + tid);
+        threads.emplace_back(std::thread(&LAHCSolver::solveThread,
+                                         *this,
+                                         std::ref(bestSequences[tid]),
+                                         std::ref(gens[tid]),
+                                         s));
+    }
+    for (int tid = 0; tid < NUM_THREADS; ++tid) {
+        threads[tid].join();
+    }
+    return bestSequence(input, bestSequences);
+}
+
+///
+/// \brief Returns the name of the solver.
+/// \return Name of the solver.
+///
+std::string LAHCSolver::name() const {
+    return "LAHC";
+}
+
+///
+/// \brief Searches on numThreads threads with the settings given at construction,
+///        restarting until the control asks to stop.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param numThreads: Number of threads to search on.
+/// \param control: Deadline and incumbent shared with other solvers.
+/// \return The best task sequence found by this solver.
+///
+Output LAHCSolver::run(int seed, int numThreads, SolveControl &control) {
+    std::vector<std::mt19937_64> gens(numThreads);
+    std::vector<std::thread> threads;
+    std::vector<Output> bestSequences(numThreads);
+    for (int tid = 0; tid < numThreads; ++tid) {
+        gens[tid].seed(seed + tid);
+        threads.emplace_back(std::thread(&LAHCSolver::runThread,
+                                         *this,
+                                         std::ref(bestSequences[tid]),
+                                         std::ref(gens[tid]),
+                                         std::ref(control)));
+    }
+    for (int tid = 0; tid < numThreads; ++tid) {
+        threads[tid].join();
+    }
+    return bestSequence(input, bestSequences);
+}
+
+///
+/// \brief Runs a single late acceptance search from a random sequence and assigns
+///        the best sequence visited to bestSequence.
+/// \param bestSequence: Assigned to be the result upon completion.
+/// \param gen: Random generator.
+/// \param s: Settings for the solver.
+///
+void LAHCSolver::solveThread(Output &bestSequence, std::mt19937_64 &gen, const Settings &s) {
+    ScheduleState state(input, randomSequence(input, gen));
+    search(state, bestSequence, gen, s);
+}
+
+///
+/// \brief Keeps searching until the control asks to stop. A restart begins from the
+///        shared incumbent if another thread or solver found a better sequence than
+///        this thread, and from a random sequence otherwise.
+/// \param bestSequence: Assigned to be the best sequence found by this thread.
+/// \param gen: Random generator.
+/// \param control: Deadline and incumbent shared with other solvers.
+///
+void LAHCSolver::runThread(Output &bestSequence, std::mt19937_64 &gen, SolveControl &control) {
+    ScheduleState state(input, randomSequence(input, gen));
+    bestSequence = state.toOutput();
+    double maxProfit = state.getProfit();
+    Output currSequence;
+    while (!control.shouldStop()) {
+        double profit = search(state, currSequence, gen, settings, &control);
+        if (profit > maxProfit) {
+            maxProfit = profit;
+            bestSequence = currSequence;
+        }
+        control.offer(currSequence, profit);
+        if (control.getIncumbentProfit() > maxProfit && control.getIncumbent(currSequence, profit)) {
+            state.assign(currSequence.getSchedule());
+        } else {
+            state.assign(randomSequence(input, gen).getSchedule());
+        }
+    }
+}
+
+///
+/// \brief Runs a single late acceptance search from the given state. Each iteration
+///        proposes a random swap or insertion with its first index inside the scheduled
+///        part of the sequence, since moves entirely past the global deadline never
+///        change the profit.
+/// \param state: Starting sequence, left at the last sequence visited.
+/// \param bestSequence: Assigned to be the best sequence visited.
+/// \param gen: Random generator.
+/// \param s: Settings for the solver.
+/// \param control: If specified, the search stops early when the control asks to stop.
+/// \return Profit of the best sequence visited.
+///
+double LAHCSolver::search(ScheduleState &state, Output &bestSequence, std::mt19937_64 &gen,
+                          const Settings &s, SolveControl *control) {
+    bestSequence = state.toOutput();
+    int n = state.size();
+    if (n < 2) {
+        return state.getProfit();
+    }
+    int historyLength = std::max(s.historyLength, 1);
+    std::vector<double> history(historyLength, state.getProfit());
+    std::uniform_int_distribution<int> uniformTaskNumDist(0, n - 1);
+    double maxProfit = state.getProfit();
+    long long iteration = 0;
+    long long idle = 0;
+
+    if (s.verbose) {
+        std::cout << "---------------- LATE ACCEPTANCE SOLVE BEGIN ----------------\n";
+        std::cout << "Printing Parameters... \n" << s;
+        std::cout << "Input size == " << n << '\n';
+        std::cout << "Initial profit == " << maxProfit << '\n';
+    }
+
+    // While the search has not been idle for long enough
+    while (idle < MIN_IDLE_ITERATIONS || idle < IDLE_RATIO * iteration) {
+        if (control && iteration % CONTROL_POLL_PERIOD == 0 && control->shouldStop()) {
+            break;
+        }
+        int index1 = std::uniform_int_distribution<int>(0, std::min(state.cutoff(), n - 1))(gen);
+        int index2 = uniformTaskNumDist(gen);
+        while (index2 == index1) {
+            index2 = uniformTaskNumDist(gen);
+        }
+        uint64_t coin = gen();
+        bool insertion = coin & 1;
+        if (insertion && (coin & 2)) {
+            std::swap(index1, index2);
+        }
+        double delta = insertion ? state.insertDelta(index1, index2) : state.swapDelta(index1, index2);
+
+        // Accept if no worse than the current profit or the profit historyLength iterations ago.
+        double& lateProfit = history[iteration % historyLength];
+        if (delta >= 0 || state.getProfit() + delta >= lateProfit) {
+            if (insertion) {
+                state.applyInsert(index1, index2);
+            } else {
+                state.applySwap(index1, index2);
+            }
+        }
+        lateProfit = state.getProfit();
+
+        if (state.getProfit() > maxProfit) {
+            if (state.getProfit() - maxProfit < PROFIT_GAIN_THRESH) {
+                ++idle;
+            } else {
+                idle = 0;
+            }
+            maxProfit = state.getProfit();
+            bestSequence = state.toOutput();
+        } else {
+            ++idle;
+        }
+        if (s.verbose && iteration % s.printPeriod == 0) {
+            std::cout << "Iteration " << iteration << ": current profit == " << state.getProfit()
+                      << ", best profit == " << maxProfit << '\n';
+        }
+        ++iteration;
+    }
+    if (s.verbose) {
+        std::cout << "SEARCH IDLE, STOPPED AFTER " << iteration << " ITERATIONS.\n";
+        std::cout << "Final profit == " << maxProfit << '\n';
+        std::cout << "---------------- LATE ACCEPTANCE SOLVE DONE ----------------\n";
+    }
+    return maxProfit;
+}
@@ -0,0 +1,65 @@
+#ifndef LAHCSOLVER_H
+#define LAHCSOLVER_H
+#include "input.h"
+#include "output.h"
+#include "schedulestate.h"
+#include "solver.h"
+#include <random>
+
+///
+/// \brief Late acceptance hill climbing solver. A candidate sequence is accepted if it
+///        is no worse than the current sequence or than the sequence that was current
+///        historyLength iterations ago. Unlike SASolver, there is no temperature to
+///        calibrate, the only parameter does not depend on the scale of the profits,
+///        and no transcendental function is called inside the search loop.
+///
+class LAHCSolver : public Solver
+{
+public:
+    static const int NUM_THREADS = 8;
+    struct Settings {
+        int historyLength;      // Number of past profits remembered by the acceptance rule.
+        bool verbose;           // Prints all details if set to true. May not work properly if NUM_THREADS is more than 1.
+        int printPeriod;        // Print a summary every this number of iterations.
+
+        Settings(int historyLength = 5000,
+                 bool verbose = false,
+                 int printPeriod = 1000000) {
+            this->historyLength = historyLength;
+            this->verbose = verbose;
+            this->printPeriod = printPeriod;
+        }
+
+        friend std::ostream& operator <<(std::ostream& out, const Settings& s) {
+            out << "GLOBAL NUM_THREADS == " << LAHCSolver::NUM_THREADS << '\n';
+            out << "History length == " << s.historyLength << '\n';
+            return out;
+        }
+    };
+
+private:
+    Input input;
+    Settings settings;
+    const int MIN_IDLE_ITERATIONS = 100000;     // The search never stops before this many iterations without profit gain.
+    const double IDLE_RATIO = 0.2;              // Otherwise it stops once the iterations without profit gain exceed
+                                                // this fraction of all iterations done.
+    const double PROFIT_GAIN_THRESH = 1e-3;     // No profit is considered gained if less than this value.
+    const int CONTROL_POLL_PERIOD = 4096;       // Check whether run() should stop every this number of iterations.
+
+public:
+    LAHCSolver();
+    LAHCSolver(const Input& in, const Settings& s = Settings());
+
+    Output solve(int seed = 0, Settings s = Settings());
+
+    std::string name() const override;
+    Output run(int seed, int numThreads, SolveControl& control) override;
+
+private:
+    void solveThread(Output& bestSequence, std::mt19937_64& gen, const Settings& s);
+    void runThread(Output& bestSequence, std::mt19937_64& gen, SolveControl& control);
+    double search(ScheduleState& state, Output& bestSequence, std::mt19937_64& gen,
+                  const Settings& s, SolveControl* control = nullptr);
+};
+
+#endif // LAHCSOLVER_H
@@ -0,0 +1,304 @@
+#include "leasequeue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+///
+/// \brief Starts renewing the lease of an item every quarter of the lease duration.
+/// \param queue: Queue holding the lease.
+/// \param item: Item claimed by this process.
+///
+LeaseQueue::Heartbeat::Heartbeat(LeaseQueue &queue, const std::string &item) : queue(queue), item(item) {
+    thread = std::thread([this] {
+        std::chrono::duration<double> period(this->queue.leaseSeconds / 4);
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopRequested.wait_for(lock, period, [this] { return stopping; })) {
+            this->queue.renew(this->item);
+        }
+    });
+}
+
+///
+/// \brief Stops renewing. The lease itself stays until completed or released.
+///
+LeaseQueue::Heartbeat::~Heartbeat() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    stopRequested.notify_all();
+    thread.join();
+}
+
+///
+/// \brief Opens the queue in a directory, creating the directory if missing.
+/// \param dir: Directory of the lease and done files, shared by all processes.
+/// \param owner: Name of this process, unique among all processes using the queue.
+/// \param leaseSeconds: Leases not renewed for this long are taken over.
+///
+LeaseQueue::LeaseQueue(const std::string &dir, const std::string &owner, double leaseSeconds)
+    : dir(dir), owner(owner), leaseSeconds(leaseSeconds) {
+    if (!this->dir.empty() && this->dir.back() != '/') {
+        this->dir += '/';
+    }
+    makeDirectories(this->dir);
+}
+
+///
+/// \brief Returns the name of this process in the leases.
+/// \return Owner name.
+///
+const std::string &LeaseQueue::getOwner() const {
+    return owner;
+}
+
+///
+/// \brief Claims an item that is neither done nor leased by a live process.
+/// \param item: Name of the item, usable as a file name.
+/// \return True if this process now holds the lease of the item.
+///
+bool LeaseQueue::claim(const std::string &item) {
+    if (isDone(item)) {
+        return false;
+    }
+    std::string held;
+    int generation = currentGeneration(item, held);
+    if (generation >= 0 && !isStale(held)) {
+        return false;
+    }
+    // Whoever creates the next generation first holds the item; everyone else finds it taken.
+    if (!createExclusive(leasePath(item, generation + 1), leaseContent())) {
+        return false;
+    }
+    if (isDone(item)) {     // finished by the previous owner just before its lease expired
+        release(item);
+        return false;
+    }
+    return true;
+}
+
+///
+/// \brief Records that the lease of an item is still alive.
+/// \param item: Item claimed by this process.
+/// \return False if the lease was taken over by another process.
+///
+bool LeaseQueue::renew(const std::string &item) {
+    int generation;
+    if (!ownsLease(item, generation)) {
+        return false;
+    }
+    // Only this process writes its generation, so a takeover meanwhile leaves it unaffected.
+    std::ofstream fs(leasePath(item, generation), std::ofstream::trunc);
+    fs << leaseContent();
+    return true;
+}
+
+///
+/// \brief Marks an item as done and releases its lease.
+/// \param item: Item claimed by this process.
+///
+void LeaseQueue::complete(const std::string &item) {
+    createExclusive(donePath(item), owner + '\n');
+    release(item);
+}
+
+///
+/// \brief Expires the lease of an item without marking it as done, so that another
+///        process can claim it right away.
+/// \param item: Item claimed by this process.
+///
+void LeaseQueue::release(const std::string &item) {
+    int generation;
+    if (ownsLease(item, generation)) {
+        std::ofstream fs(leasePath(item, generation), std::ofstream::trunc);
+        fs << owner << " 0\n";
+    }
+}
+
+///
+/// \brief Returns whether any process has completed an item.
+/// \param item: Name of the item.
+/// \return True if the item is done.
+///
+bool LeaseQueue::isDone(const std::string &item) const {
+    struct stat st;
+    return stat(donePath(item).c_str(), &st) == 0;
+}
+
+///
+/// \brief Returns a name of this process that is unique among hosts, "<host>-<pid>".
+/// \return Owner name.
+///
+std::string LeaseQueue::defaultOwner() {
+    std::string host;
+#ifdef _WIN32
+    const char* name = std::getenv("COMPUTERNAME");
+    host = name ? name : "localhost";
+    int pid = _getpid();
+#else
+    char name[256] = {0};
+    host = gethostname(name, sizeof(name) - 1) == 0 ? name : "localhost";
+    int pid = static_cast<int>(getpid());
+#endif
+    std::replace(host.begin(), host.end(), '/', '_');
+    return host + "-" + std::to_string(pid);
+}
+
+std::string LeaseQueue::leasePath(const std::string &item, int generation) const {
+    return dir + item + '.' + std::to_string(generation) + ".lease";
+}
+
+///
+/// \brief Finds the highest lease generation of an item. Generations are never removed,
+///        so they are probed upwards from zero.
+/// \param content: Assigned the content of the highest generation.
+/// \return Highest generation, -1 if the item was never claimed.
+///
+int LeaseQueue::currentGeneration(const std::string &item, std::string &content) const {
+    int generation = -1;
+    std::string next;
+    while (readWholeFile(leasePath(item, generation + 1), next)) {
+        ++generation;
+        content.swap(next);
+    }
+    return generation;
+}
+
+std::string LeaseQueue::donePath(const std::string &item) const {
+    return dir + item + ".done";
+}
+
+std::string LeaseQueue::leaseContent() const {
+    return owner + ' ' + std::to_string(static_cast<long long>(std::time(nullptr))) + '\n';
+}
+
+bool LeaseQueue::ownsLease(const std::string &item, int &generation) const {
+    std::string content;
+    std::string holder;
+    generation = currentGeneration(item, content);
+    return generation >= 0 && std::istringstream(content) >> holder && holder == owner;
+}
+
+///
+/// \brief Returns whether a lease has not been renewed for leaseSeconds. A lease that is
+///        being rewritten may be read empty or cut short, and is never stale. A released
+///        lease was renewed at time zero, so it is always stale.
+/// \param content: Content of the lease file.
+///
+bool LeaseQueue::isStale(const std::string &content) const {
+    std::istringstream ss(content);
+    std::string holder;
+    long long renewed;
+    if (!(ss >> holder >> renewed)) {
+        return false;
+    }
+    return std::difftime(std::time(nullptr), static_cast<std::time_t>(renewed)) > leaseSeconds;
+}
+
+///
+/// \brief Creates a directory and its missing parents.
+/// \param path: Directory to create.
+/// \return False if the directory does not exist afterwards.
+///
+bool makeDirectories(const std::string &path) {
+    for (size_t end = path.find('/', 1); ; end = path.find('/', end + 1)) {
+        std::string prefix = path.substr(0, end);
+        if (!prefix.empty() && prefix != "." && prefix != "..") {
+#ifdef _WIN32
+            _mkdir(prefix.c_str());
+#else
+            mkdir(prefix.c_str(), 0755);
+#endif
+        }
+        if (end == std::string::npos) {
+            break;
+        }
+    }
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && (st.st_mode & S_IFDIR);
+}
+
+///
+/// \brief Lists the entries of a directory.
+/// \param path: Directory to list.
+/// \return Names of the entries except "." and "..", sorted, empty if the directory is missing.
+///
+std::vector<std::string> listDirectory(const std::string &path) {
+    std::vector<std::string> names;
+    DIR* d = opendir(path.c_str());
+    if (!d) {
+        return names;
+    }
+    while (dirent* entry = readdir(d)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+            names.push_back(name);
+        }
+    }
+    closedir(d);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+///
+/// \brief Creates a file only if it does not exist yet, atomically with respect to other
+///        processes creating the same file.
+/// \param fileName: File to create.
+/// \param content: Content of the new file.
+/// \return False if the file already exists or cannot be created.
+///
+bool createExclusive(const std::string &fileName, const std::string &content) {
+    int fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool written = write(fd, content.data(), content.size()) == static_cast<long>(content.size());
+    close(fd);
+    return written;
+}
+
+///
+/// \brief Reads a whole file into a string.
+/// \param fileName: File to read.
+/// \param content: Assigned the content of the file.
+/// \return False if the file cannot be opened.
+///
+bool readWholeFile(const std::string &fileName, std::string &content) {
+    std::ifstream fs(fileName, std::ifstream::binary);
+    if (!fs) {
+        return false;
+    }
+    std::ostringstream ss;
+    ss << fs.rdbuf();
+    content = ss.str();
+    return true;
+}
+
+///
+/// \brief Returns when a file was last modified.
+/// \param fileName: File to examine.
+/// \param mtime: Assigned the modification time of the file.
+/// \return False if the file does not exist.
+///
+bool modificationTime(const std::string &fileName, std::time_t &mtime) {
+    struct stat st;
+    if (stat(fileName.c_str(), &st) != 0) {
+        return false;
+    }
+    mtime = st.st_mtime;
+    return true;
+}
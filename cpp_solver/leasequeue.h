@@ -0,0 +1,78 @@
+#ifndef LEASEQUEUE_H
+#define LEASEQUEUE_H
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+///
+/// \brief Work queue shared by independent processes through a directory, on one host or
+///        on hosts sharing a file system. The leases of an item are numbered generations
+///        "<item>.<generation>.lease", each holding its owner and the time it was last
+///        renewed, and the item is leased by the owner of the highest generation. A process
+///        claims an item by creating the next generation exclusively, which only one process
+///        can do, and marks it finished with "<item>.done". A lease that has not been renewed
+///        for leaseSeconds belongs to a process that died, and is taken over by the next
+///        process that claims the item. Owners only ever rewrite their own generation, so
+///        exactly one process wins every claim, and an item is only worked on twice if its
+///        owner stops renewing for leaseSeconds.
+///
+class LeaseQueue
+{
+public:
+    ///
+    /// \brief Renews a lease on a background thread until destroyed.
+    ///
+    class Heartbeat
+    {
+    private:
+        LeaseQueue& queue;
+        std::string item;
+        std::mutex mutex;
+        std::condition_variable stopRequested;
+        bool stopping = false;
+        std::thread thread;
+
+    public:
+        Heartbeat(LeaseQueue& queue, const std::string& item);
+        ~Heartbeat();
+
+        Heartbeat(const Heartbeat&) = delete;
+        Heartbeat& operator =(const Heartbeat&) = delete;
+    };
+
+private:
+    std::string dir;
+    std::string owner;
+    double leaseSeconds;
+
+public:
+    LeaseQueue(const std::string& dir, const std::string& owner, double leaseSeconds);
+
+    const std::string& getOwner() const;
+    bool claim(const std::string& item);
+    bool renew(const std::string& item);
+    void complete(const std::string& item);
+    void release(const std::string& item);
+    bool isDone(const std::string& item) const;
+
+    static std::string defaultOwner();
+
+private:
+    std::string leasePath(const std::string& item, int generation) const;
+    int currentGeneration(const std::string& item, std::string& content) const;
+    std::string donePath(const std::string& item) const;
+    std::string leaseContent() const;
+    bool ownsLease(const std::string& item, int& generation) const;
+    bool isStale(const std::string& content) const;
+};
+
+bool makeDirectories(const std::string& path);
+std::vector<std::string> listDirectory(const std::string& path);
+bool createExclusive(const std::string& fileName, const std::string& content);
+bool readWholeFile(const std::string& fileName, std::string& content);
+bool modificationTime(const std::string& fileName, std::time_t& mtime);
+
+#endif // LEASEQUEUE_H
@@ -0,0 +1,393 @@
+#include "lnssolver.h"
+#include "greedysolver.h"
+#include <algorithm>
+#include <limits>
+
+const int LNSSolver::MAX_WINDOW_SIZE;
+
+LNSSolver::LNSSolver() {}
+
+///
+/// \brief Initializes a solver instance using the Input.
+/// \param in: Problem is specified by this Input.
+/// \param s: Settings used by run().
+///
+LNSSolver::LNSSolver(const Input &in, const Settings &s) {
+    input = in;
+    settings = s;
+}
+
+///
+/// \brief Solves the problem with the seed and settings specified, re-optimizing groups
+///        on NUM_THREADS threads.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param s: Settings for the solver.
+/// \return The best task sequence found by the algorithm
+///         specified by an untrimmed Output.
+///
+Output LNSSolver::solve(int seed, Settings s) {
+    if (s.verbose) {
+        std::cout << "seed == " << seed << '\n';
+    }
+    ThreadPool pool(NUM_THREADS);
+    std::mt19937_64 gen(seed);
+    FixedScheduleState state(input, greedyStart());
+    Output bestSequence;
+    search(state, bestSequence, pool, gen, s);
+    return bestSequence;
+}
+
+///
+/// \brief Returns the name of the solver.
+/// \return Name of the solver.
+///
+std::string LNSSolver::name() const {
+    return "LNS";
+}
+
+///
+/// \brief Searches a single sequence with the settings given at construction, re-optimizing
+///        groups on numThreads threads, until the control asks to stop. A new search begins
+///        from the shared incumbent if another solver found a better sequence, and from
+///        the best sequence of this solver otherwise, after a kick.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param numThreads: Number of threads to re-optimize groups on.
+/// \param control: Deadline and incumbent shared with other solvers.
+/// \return The best task sequence found by this solver.
+///
+Output LNSSolver::run(int seed, int numThreads, SolveControl &control) {
+    ThreadPool pool(std::max(1, numThreads));
+    std::mt19937_64 gen(seed);
+    FixedScheduleState state(input, greedyStart());
+    Output bestSequence = state.toOutput();
+    double maxProfit = state.getProfit();
+    Output currSequence;
+    while (!control.shouldStop()) {
+        double profit = search(state, currSequence, pool, gen, settings, &control);
+        if (profit > maxProfit) {
+            maxProfit = profit;
+            bestSequence = currSequence;
+        }
+        control.offer(currSequence, profit);
+        if (!(control.getIncumbentProfit() > maxProfit && control.getIncumbent(currSequence, profit))) {
+            currSequence = bestSequence;
+        }
+        state.assign(currSequence.getSchedule());
+        kick(state, settings.kickSwaps, gen);
+    }
+    return bestSequence;
+}
+
+///
+/// \brief Re-optimizes a group of positions exactly. f[mask] is the largest profit of the
+///        tasks in mask placed at the first |mask| positions of the group, in some order,
+///        together with the fixed tasks that follow each of those positions up to the next
+///        one. Every task in mask is placed before the others, so the time at which the
+///        next position starts only depends on mask, and the most profitable order of all
+///        tasks of the group is found in O(2^k * k) steps, plus the fixed tasks.
+/// \param sequence: Current task sequence.
+/// \param completion: Completion time of every position of the sequence.
+/// \param move: Group to re-optimize, of at most MAX_WINDOW_SIZE positions; tasks is
+///        assigned the best order of its tasks.
+/// \return Profit gain of the best order, 0 if the current order is optimal.
+///
+FixedScheduleState::Value LNSSolver::reoptimize(const std::vector<int> &sequence, const std::vector<int> &completion,
+                                                Move &move) const {
+    typedef FixedScheduleState::Value Value;
+    const std::vector<int>& positions = move.positions;
+    int k = static_cast<int>(positions.size());
+    move.tasks.assign(k, 0);
+    move.gain = 0;
+    if (k < 2) {
+        return 0;
+    }
+    int tasks[MAX_WINDOW_SIZE];
+    int durations[MAX_WINDOW_SIZE];
+    int fixedBefore[MAX_WINDOW_SIZE];   // Total duration of the fixed tasks before each position of the group
+    int start = positions[0] > 0 ? completion[positions[0] - 1] : 0;
+    Value current = 0;
+    for (int r = 0; r < k; ++r) {
+        tasks[r] = sequence[positions[r]];
+        durations[r] = input.getDuration(tasks[r]);
+        fixedBefore[r] = r == 0 ? 0 : fixedBefore[r - 1];
+        for (int p = r > 0 ? positions[r - 1] + 1 : positions[0]; p < positions[r]; ++p) {
+            fixedBefore[r] += input.getDuration(sequence[p]);
+        }
+    }
+    for (int p = positions[0]; p <= positions[k - 1]; ++p) {
+        current += gain(sequence[p], completion[p]);
+    }
+
+    int full = (1 << k) - 1;
+    std::vector<Value> f(full + 1, std::numeric_limits<Value>::min());
+    std::vector<int> durationOf(full + 1, 0);
+    std::vector<signed char> last(full + 1, -1);
+    f[0] = 0;
+    for (int mask = 0; mask < full; ++mask) {
+        if (mask > 0) {
+            int low = __builtin_ctz(mask);
+            durationOf[mask] = durationOf[mask & (mask - 1)] + durations[low];
+        }
+        int c = __builtin_popcount(mask);
+        int time = start + durationOf[mask] + fixedBefore[c];
+        for (int j = 0; j < k; ++j) {
+            if (mask & (1 << j)) {
+                continue;
+            }
+            int end = time + durations[j];
+            Value v = f[mask] + gain(tasks[j], end);
+            if (c + 1 < k) {
+                for (int p = positions[c] + 1; p < positions[c + 1] && end <= input.getHorizon(); ++p) {
+                    end += input.getDuration(sequence[p]);
+                    v += gain(sequence[p], end);
+                }
+            }
+            if (v > f[mask | (1 << j)]) {
+                f[mask | (1 << j)] = v;
+                last[mask | (1 << j)] = static_cast<signed char>(j);
+            }
+        }
+    }
+    if (f[full] <= current) {
+        for (int r = 0; r < k; ++r) {
+            move.tasks[r] = tasks[r];
+        }
+        return 0;
+    }
+    for (int mask = full, r = k - 1; r >= 0; --r) {
+        move.tasks[r] = tasks[last[mask]];
+        mask ^= 1 << last[mask];
+    }
+    move.gain = f[full] - current;
+    return move.gain;
+}
+
+///
+/// \brief Descends and kicks from the given state until maxNoImprove kicks bring no
+///        profit gain. A kicked local optimum replaces the current one if no worse.
+/// \param state: Starting sequence, left at the current local optimum.
+/// \param bestSequence: Assigned to be the best sequence found.
+/// \param pool: Threads to re-optimize groups on.
+/// \param gen: Random generator.
+/// \param s: Settings for the solver.
+/// \param control: If specified, the search stops early when the control asks to stop,
+///        and improvements are offered to it as they are found.
+/// \return Profit of the best sequence found.
+///
+double LNSSolver::search(FixedScheduleState &state, Output &bestSequence, ThreadPool &pool, std::mt19937_64 &gen,
+                         const Settings &s, SolveControl *control) const {
+    descend(state, pool, gen, s);
+    bestSequence = state.toOutput();
+    double maxProfit = state.getProfit();
+    if (state.size() < 2) {
+        return maxProfit;
+    }
+
+    if (s.verbose) {
+        std::cout << "---------------- LNS SOLVE BEGIN ----------------\n";
+        std::cout << "Printing Parameters... \n" << s;
+        std::cout << "Input size == " << state.size() << '\n';
+        std::cout << "Initial local optimum == " << maxProfit << '\n';
+    }
+
+    std::vector<int> current = state.getSequence();
+    FixedScheduleState::Value currValue = state.getValue();
+    int kicks = 0;
+    for (int idle = 0; idle < s.maxNoImprove && !(control && control->shouldStop()); ++kicks) {
+        kick(state, s.kickSwaps, gen);
+        descend(state, pool, gen, s);
+        if (state.getValue() >= currValue) {
+            current = state.getSequence();
+            currValue = state.getValue();
+        } else {
+            state.assign(current);
+        }
+
+        if (state.getProfit() - maxProfit >= PROFIT_GAIN_THRESH) {
+            idle = 0;
+        } else {
+            ++idle;
+        }
+        if (state.getProfit() > maxProfit) {
+            maxProfit = state.getProfit();
+            bestSequence = state.toOutput();
+            if (control && maxProfit > control->getIncumbentProfit()) {
+                control->offer(bestSequence, maxProfit);
+            }
+        }
+        if (s.verbose && kicks % s.printPeriod == 0) {
+            std::cout << "Kick " << kicks << ": current profit == " << state.getProfit()
+                      << ", best profit == " << maxProfit << '\n';
+        }
+    }
+    if (s.verbose) {
+        std::cout << "SEARCH IDLE, STOPPED AFTER " << kicks << " KICKS.\n";
+        std::cout << "Final profit == " << maxProfit << '\n';
+        std::cout << "---------------- LNS SOLVE DONE ----------------\n";
+    }
+    return maxProfit;
+}
+
+///
+/// \brief Runs rounds until IDLE_ROUNDS_FACTOR * windowSize rounds in a row bring no gain,
+///        so that windows have been tried at every offset.
+/// \return Number of improving rounds.
+///
+int LNSSolver::descend(FixedScheduleState &state, ThreadPool &pool, std::mt19937_64 &gen, const Settings &s) const {
+    int improving = 0;
+    int k = std::max(2, std::min(s.windowSize, MAX_WINDOW_SIZE));
+    for (int idle = 0; idle < IDLE_ROUNDS_FACTOR * k; ) {
+        if (round(state, pool, gen, s)) {
+            ++improving;
+            idle = 0;
+        } else {
+            ++idle;
+        }
+    }
+    return improving;
+}
+
+///
+/// \brief Re-optimizes groups with disjoint spans in parallel and applies every improvement.
+/// \return False if no group improved.
+///
+bool LNSSolver::round(FixedScheduleState &state, ThreadPool &pool, std::mt19937_64 &gen, const Settings &s) const {
+    int k = std::max(2, std::min(s.windowSize, MAX_WINDOW_SIZE));
+    bool related = std::uniform_real_distribution<double>(0.0, 1.0)(gen) < s.relatedShare;
+    std::vector<Move> moves = related ? relatedGroups(state, k, gen) : windowGroups(state, k, gen);
+
+    const std::vector<int>& sequence = state.getSequence();
+    std::vector<int> completion(sequence.size());
+    for (size_t p = 0, time = 0; p < sequence.size(); ++p) {
+        time += input.getDuration(sequence[p]);
+        completion[p] = static_cast<int>(time);
+    }
+    int stripes = std::min(pool.size(), static_cast<int>(moves.size()));
+    pool.parallelFor(stripes, [&](int w) {
+        for (size_t g = w; g < moves.size(); g += stripes) {
+            reoptimize(sequence, completion, moves[g]);
+        }
+    });
+
+    std::vector<int> improved = sequence;
+    bool gained = false;
+    for (const Move& move : moves) {
+        if (move.gain > 0) {
+            for (size_t r = 0; r < move.positions.size(); ++r) {
+                improved[move.positions[r]] = move.tasks[r];
+            }
+            gained = true;
+        }
+    }
+    if (gained) {
+        state.assign(improved);
+    }
+    return gained;
+}
+
+///
+/// \brief Tiles the scheduled part of the sequence with windows of k consecutive
+///        positions, starting at a random offset.
+///
+std::vector<LNSSolver::Move> LNSSolver::windowGroups(const FixedScheduleState &state, int k,
+                                                     std::mt19937_64 &gen) const {
+    int n = state.size();
+    int cutoff = std::min(state.cutoff(), n - 1);
+    int offset = std::uniform_int_distribution<int>(0, k - 1)(gen);
+    std::vector<Move> moves;
+    for (int first = offset > 1 ? offset - k : offset; first <= cutoff; first += k) {
+        Move move;
+        for (int p = std::max(0, first); p < std::min(n, first + k); ++p) {
+            move.positions.push_back(p);
+        }
+        if (move.positions.size() > 1) {
+            moves.push_back(move);
+        }
+    }
+    return moves;
+}
+
+///
+/// \brief Draws groups of k related tasks with disjoint spans. Each group holds a random
+///        task of the scheduled part of the sequence and the k - 1 tasks whose deadlines are
+///        closest to its deadline, wherever they are, so tasks past the global deadline can
+///        be brought into the schedule.
+///
+std::vector<LNSSolver::Move> LNSSolver::relatedGroups(const FixedScheduleState &state, int k,
+                                                      std::mt19937_64 &gen) const {
+    int n = state.size();
+    int cutoff = std::min(state.cutoff(), n - 1);
+    std::uniform_int_distribution<int> seedDist(0, cutoff);
+    std::vector<std::pair<int, int>> spans;
+    std::vector<Move> moves;
+    for (int attempt = 0; attempt <= cutoff / k; ++attempt) {
+        int seed = seedDist(gen);
+        int deadline = input.getDeadline(state.taskAt(seed));
+        std::vector<std::pair<int, int>> candidates;    // (deadline distance, position)
+        for (int p = 0; p < n; ++p) {
+            if (p != seed) {
+                candidates.push_back(std::make_pair(std::abs(input.getDeadline(state.taskAt(p)) - deadline), p));
+            }
+        }
+        int take = std::min(k - 1, static_cast<int>(candidates.size()));
+        std::partial_sort(candidates.begin(), candidates.begin() + take, candidates.end());
+        Move move;
+        move.positions.push_back(seed);
+        for (int c = 0; c < take; ++c) {
+            move.positions.push_back(candidates[c].second);
+        }
+        std::sort(move.positions.begin(), move.positions.end());
+        std::pair<int, int> span(move.positions.front(), move.positions.back());
+        bool disjoint = true;
+        for (const std::pair<int, int>& other : spans) {
+            disjoint = disjoint && (span.second < other.first || other.second < span.first);
+        }
+        if (disjoint && move.positions.size() > 1) {
+            spans.push_back(span);
+            moves.push_back(move);
+        }
+    }
+    return moves;
+}
+
+///
+/// \brief Perturbs the sequence with random swaps, each with its first index inside the
+///        scheduled part of the sequence.
+/// \param state: Sequence to perturb.
+/// \param swaps: Number of swaps.
+/// \param gen: Random generator.
+///
+void LNSSolver::kick(FixedScheduleState &state, int swaps, std::mt19937_64 &gen) const {
+    int n = state.size();
+    if (n < 2) {
+        return;
+    }
+    std::uniform_int_distribution<int> uniformTaskNumDist(0, n - 1);
+    for (int k = 0; k < swaps; ++k) {
+        int index1 = std::uniform_int_distribution<int>(0, std::min(state.cutoff(), n - 1))(gen);
+        int index2 = uniformTaskNumDist(gen);
+        while (index2 == index1) {
+            index2 = uniformTaskNumDist(gen);
+        }
+        state.applySwap(index1, index2);
+    }
+}
+
+///
+/// \brief Returns the profit earned by a task completing at a time, as FixedScheduleState does.
+///
+FixedScheduleState::Value LNSSolver::gain(int task, int time) const {
+    if (time > input.getHorizon()) {
+        return 0;
+    }
+    return FixedProfit::gain(input, task, time - input.getDeadline(task));
+}
+
+///
+/// \brief Returns the most profitable greedy sequence, the starting point of the search.
+/// \return Greedy task sequence specified by an Output.
+///
+Output LNSSolver::greedyStart() const {
+    GreedySolver gs(input);
+    return gs.solve();
+}
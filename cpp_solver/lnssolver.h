@@ -0,0 +1,95 @@
+#ifndef LNSSOLVER_H
+#define LNSSOLVER_H
+#include "input.h"
+#include "output.h"
+#include "schedulestate.h"
+#include "solver.h"
+#include "threadpool.h"
+#include <random>
+
+///
+/// \brief Large neighbourhood search solver. Every round picks groups of windowSize
+///        positions of the current sequence and re-optimizes each group exactly: the tasks
+///        at its positions are permuted among them in the most profitable order, found by
+///        dynamic programming over the subsets of the group. A group is either a window of
+///        consecutive positions or, in a share of the rounds, positions of related tasks,
+///        whose deadlines are close to each other, and the tasks between them shift along.
+///        Every task outside the span of a group keeps its completion time, so groups with
+///        disjoint spans are re-optimized in parallel and all improvements are applied at
+///        once. Once rounds stop improving, the sequence is kicked with a few random swaps
+///        and the search continues from the new local optimum if it is no worse.
+///
+class LNSSolver : public Solver
+{
+public:
+    static const int NUM_THREADS = 8;
+    static const int MAX_WINDOW_SIZE = 16;
+    struct Settings {
+        int windowSize;         // Number of positions re-optimized together, at most MAX_WINDOW_SIZE.
+        double relatedShare;    // Fraction of rounds that re-optimize related tasks instead of windows.
+        int kickSwaps;          // Random swaps applied to the current local optimum before each descent.
+        int maxNoImprove;       // Number of kicks allowed with no profit gain.
+        bool verbose;           // Prints all details if set to true.
+        int printPeriod;        // Print a summary every this number of kicks.
+
+        Settings(int windowSize = 10,
+                 double relatedShare = 0.5,
+                 int kickSwaps = 3,
+                 int maxNoImprove = 200,
+                 bool verbose = false,
+                 int printPeriod = 50) {
+            this->windowSize = windowSize;
+            this->relatedShare = relatedShare;
+            this->kickSwaps = kickSwaps;
+            this->maxNoImprove = maxNoImprove;
+            this->verbose = verbose;
+            this->printPeriod = printPeriod;
+        }
+
+        friend std::ostream& operator <<(std::ostream& out, const Settings& s) {
+            out << "GLOBAL NUM_THREADS == " << LNSSolver::NUM_THREADS << '\n';
+            out << "Window size == " << s.windowSize << '\n';
+            out << "Related task share == " << s.relatedShare << '\n';
+            out << "Kick swaps == " << s.kickSwaps << '\n';
+            out << "Max kicks with no profit gain == " << s.maxNoImprove << '\n';
+            return out;
+        }
+    };
+
+    struct Move {
+        std::vector<int> positions;     // Increasing positions of the group.
+        std::vector<int> tasks;         // Task placed at each position.
+        FixedScheduleState::Value gain = 0;
+    };
+
+private:
+    Input input;
+    Settings settings;
+    const double PROFIT_GAIN_THRESH = 1e-3;     // No profit is considered gained if less than this value.
+    const int IDLE_ROUNDS_FACTOR = 2;           // A descent stops after this many times windowSize rounds without gain.
+
+public:
+    LNSSolver();
+    LNSSolver(const Input& in, const Settings& s = Settings());
+
+    Output solve(int seed = 0, Settings s = Settings());
+
+    std::string name() const override;
+    Output run(int seed, int numThreads, SolveControl& control) override;
+
+    FixedScheduleState::Value reoptimize(const std::vector<int>& sequence, const std::vector<int>& completion,
+                                         Move& move) const;
+
+private:
+    double search(FixedScheduleState& state, Output& bestSequence, ThreadPool& pool, std::mt19937_64& gen,
+                  const Settings& s, SolveControl* control = nullptr) const;
+    int descend(FixedScheduleState& state, ThreadPool& pool, std::mt19937_64& gen, const Settings& s) const;
+    bool round(FixedScheduleState& state, ThreadPool& pool, std::mt19937_64& gen, const Settings& s) const;
+    std::vector<Move> windowGroups(const FixedScheduleState& state, int k, std::mt19937_64& gen) const;
+    std::vector<Move> relatedGroups(const FixedScheduleState& state, int k, std::mt19937_64& gen) const;
+    void kick(FixedScheduleState& state, int swaps, std::mt19937_64& gen) const;
+    FixedScheduleState::Value gain(int task, int time) const;
+    Output greedyStart() const;
+};
+
+#endif // LNSSOLVER_H
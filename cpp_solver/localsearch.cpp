@@ -0,0 +1,126 @@
+#include "localsearch.h"
+#include <algorithm>
+
+///
+/// \brief Initializes a local search instance using the Input.
+/// \param in: Problem is specified by this Input.
+///
+LocalSearch::LocalSearch(const Input &in) : input(in) {}
+
+///
+/// \brief Descends from an Output to a local optimum.
+/// \param output: Initial task sequence, possibly trimmed. Missing tasks are appended.
+/// \return The local optimum, its profit, and the number of moves applied.
+///
+LocalSearch::Result LocalSearch::polish(const Output &output) const {
+    FixedScheduleState state(input, output);
+    Result result;
+    result.moves = descend(state);
+    result.output = state.toOutput();
+    result.profit = result.output.evaluate(input);
+    return result;
+}
+
+///
+/// \brief Applies the best improving move until none is left.
+/// \param state: Sequence to improve, for the Input of this local search.
+/// \return Number of moves applied.
+///
+int LocalSearch::descend(FixedScheduleState &state) const {
+    int moves = 0;
+    while (true) {
+        Move move = bestSwap(state);
+        Move segment = bestSegment(state, 1, MAX_SEGMENT_LENGTH);   // an insertion is a segment of length one
+        if (segment.delta > move.delta) {
+            move = segment;
+        }
+        if (move.delta <= 0) {
+            return moves;
+        }
+        apply(state, move);
+        ++moves;
+    }
+}
+
+///
+/// \brief Finds the most profitable swap. Swaps of two positions past the global
+///        deadline never change the profit and are skipped.
+/// \param state: Current sequence.
+/// \param evaluations: If specified, the number of swaps evaluated is added to it.
+/// \return The best swap, with a delta of 0 if no swap improves the profit.
+///
+LocalSearch::Move LocalSearch::bestSwap(const FixedScheduleState &state, long long *evaluations) {
+    Move best;
+    int n = state.size();
+    int cutoff = std::min(state.cutoff(), n - 1);
+    for (int i = 0; i <= cutoff; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            FixedScheduleState::Value delta = state.swapDelta(i, j);
+            if (delta > best.delta) {
+                best.delta = delta;
+                best.from = i;
+                best.to = j;
+            }
+        }
+        if (evaluations) {
+            *evaluations += n - 1 - i;
+        }
+    }
+    return best;
+}
+
+///
+/// \brief Finds the most profitable move of a block of minLength to maxLength tasks,
+///        shorter blocks first. A block can only gain by moving if it starts within the
+///        global deadline or moves to a position within it; other moves are skipped.
+/// \param state: Current sequence.
+/// \param minLength: Length of the shortest blocks, 1 for insertions.
+/// \param maxLength: Length of the longest blocks, limited to size() - 1.
+/// \param evaluations: If specified, the number of moves evaluated is added to it.
+/// \return The best move, with a delta of 0 if no move improves the profit.
+///
+LocalSearch::Move LocalSearch::bestSegment(const FixedScheduleState &state, int minLength, int maxLength,
+                                           long long *evaluations) {
+    Move best;
+    int n = state.size();
+    int cutoff = std::min(state.cutoff(), n - 1);
+    long long evaluated = 0;
+    for (int length = minLength; length <= maxLength && length < n; ++length) {
+        for (int from = 0; from + length <= n; ++from) {
+            int maxTo = from <= cutoff ? n - length : std::min(cutoff, n - length);
+            for (int to = 0; to <= maxTo; ++to) {
+                if (to == from) {
+                    continue;
+                }
+                FixedScheduleState::Value delta = length == 1 ? state.insertDelta(from, to)
+                                                              : state.segmentDelta(from, length, to);
+                ++evaluated;
+                if (delta > best.delta) {
+                    best.delta = delta;
+                    best.from = from;
+                    best.length = length;
+                    best.to = to;
+                }
+            }
+        }
+    }
+    if (evaluations) {
+        *evaluations += evaluated;
+    }
+    return best;
+}
+
+///
+/// \brief Applies a move found by bestSwap or bestSegment.
+/// \param state: Sequence the move was found on.
+/// \param move: Move to apply.
+///
+void LocalSearch::apply(FixedScheduleState &state, const Move &move) {
+    if (move.length == 0) {
+        state.applySwap(move.from, move.to);
+    } else if (move.length == 1) {
+        state.applyInsert(move.from, move.to);
+    } else {
+        state.applySegment(move.from, move.length, move.to);
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+#include "input.h"
+#include "output.h"
+#include "schedulestate.h"
+
+///
+/// \brief Best-improvement local search over swap, insertion, and or-opt (segment)
+///        moves. Every iteration evaluates the whole neighbourhood of the current
+///        sequence incrementally in fixed-point arithmetic and applies the single best
+///        move, until no move improves the profit. Moves entirely past the global
+///        deadline never change the profit and are skipped. Deterministic. The scans of
+///        the swap and segment neighbourhoods are static, so that other engines, such as
+///        VNSSolver, search the same moves.
+///
+class LocalSearch
+{
+public:
+    static const int MAX_SEGMENT_LENGTH = 3;    // Or-opt moves blocks of 2 to MAX_SEGMENT_LENGTH tasks.
+
+    struct Result {
+        Output output;          // Untrimmed local optimum.
+        double profit = 0.0;    // Profit of the output, from Output::evaluate.
+        int moves = 0;          // Number of improving moves applied.
+    };
+
+    struct Move {
+        int from = 0;           // Position of the first task moved.
+        int length = 0;         // Number of tasks moved, 0 for a swap of the tasks at from and to.
+        int to = 0;             // Position of the first task moved after the move.
+        FixedScheduleState::Value delta = 0;    // Profit gain, 0 if no move of the neighbourhood improves.
+    };
+
+private:
+    Input input;
+
+public:
+    LocalSearch(const Input& in);
+
+    Result polish(const Output& output) const;
+    int descend(FixedScheduleState& state) const;
+
+    static Move bestSwap(const FixedScheduleState& state, long long* evaluations = nullptr);
+    static Move bestSegment(const FixedScheduleState& state, int minLength, int maxLength,
+                            long long* evaluations = nullptr);
+    static void apply(FixedScheduleState& state, const Move& move);
+};
+
+#endif // LOCALSEARCH_H
@@ -1,9 +1,26 @@
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
 #include "sasolver.h"
+#include "tabusolver.h"
+#include "lahcsolver.h"
+#include "memeticsolver.h"
+#include "dynasearchsolver.h"
+#include "lnssolver.h"
+#include "vnssolver.h"
 #include "greedysolver.h"
+#include "portfolio.h"
+#include "presets.h"
+#include "packedcorpus.h"
+#include "resultcache.h"
+#include "leasequeue.h"
+#include "localsearch.h"
+#include "threadpool.h"
 
 using namespace std;
 
@@ -19,6 +36,12 @@ const string SMALL_PREFIX = "small-";
 const string INPUT_POSTFIX = ".in";
 const string OUTPUT_POSTFIX = ".out";
 const string LOG_POSTFIX = ".log";
+const string METRICS_POSTFIX = ".metrics.json";
+
+// Inputs packed by tools/packcorpus.cpp. If the file exists, solveBatch reads instances
+// from it instead of parsing the text files in INPUT_DIR, except those whose text file is
+// not older than the pack, so that inputs edited after packing are read again.
+const string PACKED_CORPUS = "../inputs.pack";
 
 // Change settings here for different performance.
 /* Usage: SASolver::Settings(int maxRestarts,
@@ -27,91 +50,444 @@ const string LOG_POSTFIX = ".log";
  *                           double epochSizeFactor,
  *                           double initAccRate,
  *                           bool verbose,
- *                           int epochPrintPeriod)
+ *                           int epochPrintPeriod,
+ *                           bool fixedPoint,
+ *                           string traceFile,
+ *                           int moveWindow,
+ *                           ThreadPlacement::Policy placement,
+ *                           int dynasearchPeriod)
  *
  * maxRestarts: number of restarts to perform after system frozen
  * alpha: temperature decay rate, must be a fraction between 0.0 and 1.0 (exclusive)
  * maxRejections: number of epochs allowed with no profit gain
  * epochSizeFactor: Size of each epoch == epochSizeFactor * n * n
  * initAccRate: target initial acceptance rate for downhill movements
+ * fixedPoint: evaluate perturbations incrementally in exact fixed-point arithmetic,
+ *             faster but does not reproduce the submitted outputs
+ * traceFile: CSV of epoch progress (temperature, profit, acceptance rate) of every thread,
+ *            written by a background thread; verbose traces to stdout instead if empty
+ * moveWindow: if positive, swap only positions at most this far apart (large-instance mode)
+ * placement: pin threads to one per physical core (PHYSICAL_CORES), to both hardware
+ *            threads of each core in turn (SMT_SIBLINGS), or not at all (NONE); the CPU
+ *            of every thread is written to the log file
+ * dynasearchPeriod: if positive, improve the current sequence with dynasearch (see
+ *                   dynasearch.h) every dynasearchPeriod epochs and once frozen
  */
 const SASolver::Settings settings(0, 0.999, 50, 1.0, 0.8);
 
-void solveBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix);
+/* Usage: TabuSolver::Settings(int maxIterations,
+ *                             int maxNoImprove,
+ *                             int tenure,
+ *                             bool useInsertions,
+ *                             bool greedyStart,
+ *                             bool verbose,
+ *                             int printPeriod)
+ *
+ * maxIterations: maximum number of moves applied
+ * maxNoImprove: number of iterations allowed with no profit gain
+ * tenure: number of iterations a task may not return to a position it left
+ * useInsertions: scan insertion moves in addition to swaps
+ * greedyStart: start from the best greedy sequence instead of a random one
+ */
+const TabuSolver::Settings tabuSettings(100000, 2000, 20, true, true);
+
+/* Usage: LAHCSolver::Settings(int historyLength,
+ *                             bool verbose,
+ *                             int printPeriod)
+ *
+ * historyLength: number of past profits remembered by the acceptance rule,
+ *                longer histories search longer and accept more downhill movements
+ */
+const LAHCSolver::Settings lahcSettings(5000);
+
+/* Usage: MemeticSolver::Settings(int populationSize,
+ *                                int maxGenerations,
+ *                                int maxStagnation,
+ *                                double localSearchFactor,
+ *                                bool verbose,
+ *                                int printPeriod)
+ *
+ * populationSize: number of sequences kept between generations
+ * maxGenerations: maximum number of generations
+ * maxStagnation: number of generations allowed with no profit gain
+ * localSearchFactor: local search moves per offspring == localSearchFactor * n * n
+ */
+const MemeticSolver::Settings memeticSettings(40, 1000, 50, 0.5);
+
+/* Usage: DynasearchSolver::Settings(int kickSwaps,
+ *                                   int maxNoImprove,
+ *                                   int maxSpan,
+ *                                   bool verbose,
+ *                                   int printPeriod)
+ *
+ * kickSwaps: number of random swaps applied to the current local optimum before each descent
+ * maxNoImprove: number of kicks allowed with no profit gain
+ * maxSpan: if positive, dynasearch moves span at most this many positions
+ */
+const DynasearchSolver::Settings dynasearchSettings(3, 500);
+
+/* Usage: LNSSolver::Settings(int windowSize,
+ *                            double relatedShare,
+ *                            int kickSwaps,
+ *                            int maxNoImprove,
+ *                            bool verbose,
+ *                            int printPeriod)
+ *
+ * windowSize: number of positions re-optimized together by dynamic programming, at most 16
+ * relatedShare: fraction of rounds that re-optimize tasks with close deadlines instead of
+ *               consecutive positions
+ * kickSwaps: number of random swaps applied to the current local optimum before each descent
+ * maxNoImprove: number of kicks allowed with no profit gain
+ */
+const LNSSolver::Settings lnsSettings(10, 0.5, 3, 200);
+
+/* Usage: VNSSolver::Settings(int minShake,
+ *                            int maxShake,
+ *                            int maxBlock,
+ *                            int maxNoImprove,
+ *                            bool verbose,
+ *                            int printPeriod)
+ *
+ * minShake, maxShake: a shake applies k random moves to the current local optimum, where k
+ *                     restarts at minShake after an improvement and otherwise grows up to maxShake
+ * maxBlock: block moves shift blocks of 2 to maxBlock tasks
+ * maxNoImprove: number of shakes allowed with no profit gain
+ */
+const VNSSolver::Settings vnsSettings(1, 8, 3, 400);
+
+// Engine used by solveBatch, ignored if USE_PORTFOLIO is set.
+const Engine ENGINE = SIMULATED_ANNEALING;
+
+// If set, solveBatch runs a Portfolio instead: several engines run concurrently on
+// PORTFOLIO_CORES cores for PORTFOLIO_TIME_BUDGET seconds per instance, sharing the best
+// sequence found. Engines and their settings per size class are configured in portfolio.cpp.
+// The portfolio includes the greedy algorithms, so fixAll has nothing left to fix.
+const bool USE_PORTFOLIO = false;
+const int PORTFOLIO_CORES = 8;
+const double PORTFOLIO_TIME_BUDGET = 60.0;
+const Portfolio portfolio;
+
+// Settings tuned per size class by benchmark/tuner.cpp. If the file exists, solveBatch
+// uses its alpha, maxRejections, epochSizeFactor, and initAccRate for the SIMULATED_ANNEALING
+// engine instead of those in settings above.
+const string PRESET_FILE = "sa_presets.txt";
+
+// Best output found so far for each input contents and configuration (see resultcache.h).
+// solveBatch skips instances found in the cache, so inputs are re-solved only when their
+// contents, the engine, or its settings change. Delete the file to solve everything again,
+// except that an empty cache is first seeded with the existing output of every instance
+// that has a log file, which is how instances were skipped before the cache existed.
+// Whatever the cache says, an output file is only ever replaced by a more profitable one,
+// and improvements made by fixAll and polishAll are stored in the cache as well.
+const string RESULT_CACHE = "../outputs/results.cache";
+
+// If set, several processes of this program, on one host or on hosts sharing the repository,
+// solve the inputs together. A process claims every instance in SHARD_QUEUE_DIR before
+// solving it (see leasequeue.h), so each instance is solved once, and instances claimed by
+// a process that died are solved again once their lease is SHARD_LEASE_SECONDS old. Each
+// process writes its outputs, logs, and result cache to SHARD_DIR/<host>-<pid>/, and skips
+// fixAll and polishAll. Run "./solve merge" once all processes are done to copy the best
+// output of every instance to OUTPUT_DIR and merge the result caches, then fix and polish.
+// Instances are queued by ResultCache key, so a configuration change queues them again.
+const bool USE_SHARDING = false;
+const string SHARD_QUEUE_DIR = "../outputs/queue/";
+const string SHARD_DIR = "../outputs/shards/";
+const double SHARD_LEASE_SECONDS = 600.0;
+
+// polishAll runs LocalSearch on every existing output, POLISH_THREADS instances at a time,
+// and rewrites an output only if its profit improves by more than POLISH_GAIN_THRESH.
+const int POLISH_THREADS = max(1, static_cast<int>(thread::hardware_concurrency()));
+const double POLISH_GAIN_THRESH = 1e-6;
+
+void solveBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix,
+                ResultCache& cache, LeaseQueue* queue, bool seedFromLogs);
 void solveAll();
-void fixBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix);
+void mergeBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix,
+                const vector<string>& shards, const string& sizeDir);
+void mergeShards();
+void fixBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix,
+              ResultCache& cache, const SettingsPresets& presets);
 void fixAll();
+void polishBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix,
+                 ResultCache& cache, const SettingsPresets& presets, ThreadPool& pool);
+void polishAll();
 double greedyProfit(const Input& in, Output& out);
+double existingProfit(const Input& in, const string& outputFileName);
+string describeConfig(const Input& in, const SettingsPresets& presets);
 
 
 //-----------------------------------------------------------------------------
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "merge") {
+        mergeShards();
+        fixAll();
+        polishAll();
+        return 0;
+    }
     solveAll();
-    fixAll();
+    if (!USE_SHARDING) {
+        fixAll();
+        polishAll();
+    }
     return 0;
 }
 
 //----------------------------------------------------------------------------
 
-void solveBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix) {
+void solveBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix,
+                ResultCache& cache, LeaseQueue* queue, bool seedFromLogs) {
+    static const PackedCorpus corpus(PACKED_CORPUS);
+    std::time_t packTime = 0;
+    bool usePack = corpus.isOpen() && modificationTime(PACKED_CORPUS, packTime);
     fstream fs;
     Input in;
     Output out;
     std::time_t tt;
+    SettingsPresets presets(settings);
+    presets.readFile(PRESET_FILE);
 
     for (int i = 1; i <= 300; ++i) {
         string inputFileName = inDir + prefix + to_string(i) + INPUT_POSTFIX;
         string outputFileName = outDir + prefix + to_string(i) + OUTPUT_POSTFIX;
         string logFileName = logDir + prefix + to_string(i) + LOG_POSTFIX;
 
-        // skip if log file already exists
-        fs.open(logFileName, fstream::in);
-        if (fs.good()) {
-            fs.close();
-            continue;
-        }
-
         // Read input
         auto start = chrono::system_clock::now();
-        in = Input(inputFileName);
+        int packed = usePack ? corpus.find(prefix + to_string(i)) : -1;
+        std::time_t inputTime;
+        if (packed >= 0 && modificationTime(inputFileName, inputTime) && inputTime >= packTime) {
+            packed = -1;    // edited after packing
+        }
+        in = packed >= 0 ? corpus.input(packed) : Input(inputFileName);
 
         // skip if input file does not exist
         if (in.failed()) {
             continue;
         }
 
+        // skip if solved before with the same configuration, restoring the output if missing or worse
+        string config = describeConfig(in, presets);
+        uint64_t key = ResultCache::key(in, config);
+        ResultCache::Record cached;
+        double oldProfit = existingProfit(in, outputFileName);
+        if (cache.lookup(key, cached)) {
+            if (cached.profit > oldProfit) {
+                cached.output.trim(in);
+                cached.output.writeFile(outputFileName);
+            }
+            continue;
+        }
+
+        // skip if solved before the cache existed, adopting the existing output
+        fs.open(logFileName, fstream::in);
+        bool logged = fs.good();
+        fs.close();
+        if (seedFromLogs && logged && oldProfit >= 0) {
+            cache.store(key, Output(outputFileName), oldProfit, 0.0);
+            continue;
+        }
+
+        // skip if solved or being solved by another process
+        stringstream item;
+        item << hex << setw(16) << setfill('0') << key;
+        if (queue && !queue->claim(item.str())) {
+            continue;
+        }
+        unique_ptr<LeaseQueue::Heartbeat> heartbeat(queue ? new LeaseQueue::Heartbeat(*queue, item.str()) : nullptr);
+
         // Begin solving
-        SASolver sas = SASolver(in);
-        out = sas.solve(0, settings);
+        clock_t cpuStart = clock();
+        string placement;
+        if (USE_PORTFOLIO) {
+            out = portfolio.solve(in, PORTFOLIO_CORES, PORTFOLIO_TIME_BUDGET);
+        } else if (ENGINE == TABU_SEARCH) {
+            TabuSolver ts = TabuSolver(in);
+            out = ts.solve(0, tabuSettings);
+        } else if (ENGINE == LATE_ACCEPTANCE) {
+            LAHCSolver lahcs = LAHCSolver(in);
+            out = lahcs.solve(0, lahcSettings);
+        } else if (ENGINE == MEMETIC) {
+            MemeticSolver ms = MemeticSolver(in);
+            out = ms.solve(0, memeticSettings);
+        } else if (ENGINE == DYNASEARCH) {
+            DynasearchSolver ds = DynasearchSolver(in);
+            out = ds.solve(0, dynasearchSettings);
+        } else if (ENGINE == LARGE_NEIGHBOURHOOD) {
+            LNSSolver lnss = LNSSolver(in);
+            out = lnss.solve(0, lnsSettings);
+        } else if (ENGINE == VARIABLE_NEIGHBOURHOOD) {
+            VNSSolver vnss = VNSSolver(in);
+            out = vnss.solve(0, vnsSettings);
+        } else {
+            SASolver sas = SASolver(in);
+            out = sas.solve(0, presets.forInput(in));
+            writeMetricsReport(logDir + prefix + to_string(i) + METRICS_POSTFIX, prefix + to_string(i), "SA",
+                               chrono::duration<double>(chrono::system_clock::now() - start).count(),
+                               sas.getMetrics());
+            for (size_t tid = 0; tid < sas.getMetrics().size(); ++tid) {
+                if (sas.getMetrics()[tid].cpu >= 0) {
+                    placement += "Thread " + to_string(tid) + " == " + ThreadPlacement::describe(sas.getMetrics()[tid].cpu) + '\n';
+                }
+            }
+        }
+        double cpuSeconds = static_cast<double>(clock() - cpuStart) / CLOCKS_PER_SEC;
         auto stop = chrono::system_clock::now();
         auto duration = chrono::duration_cast<chrono::seconds>(stop - start);
+        double profit = out.evaluate(in);
+        cache.store(key, out, profit, cpuSeconds);
+
+        // keep the existing output, and its log, unless the new one is more profitable
+        if (profit <= oldProfit) {
+            cout << "Kept " << prefix << i << ": " << oldProfit << " >= " << profit << endl;
+            if (queue) {
+                heartbeat.reset();
+                queue->complete(item.str());
+            }
+            continue;
+        }
 
         // write log file
         fs.open(logFileName, fstream::out);
-        fs << out.evaluate(in) << endl;
+        fs << profit << endl;
         fs << out << endl;
-        fs << settings << endl;
+        fs << config << endl;
         tt = std::chrono::system_clock::to_time_t(start);
         fs << "Start time == " << ctime(&tt);
         tt = std::chrono::system_clock::to_time_t(stop);
         fs << "Stop time == " << ctime(&tt);
         fs << "Elapsed time == " << duration.count() << " seconds\n";
+        fs << "CPU time == " << cpuSeconds << " seconds\n";
+        fs << placement;
         fs.close();
 
         // write output file
         out.trim(in);
         out.writeFile(outputFileName);
+        if (queue) {
+            heartbeat.reset();
+            queue->complete(item.str());
+        }
     }
 }
 
+///
+/// \brief Describes the engine and settings solveBatch uses for an Input, as written to
+///        its log file. Also part of its ResultCache key, so any change in the description
+///        makes solveBatch solve the Input again.
+/// \param in: Input to be solved.
+/// \param presets: Presets of the SIMULATED_ANNEALING engine.
+/// \return Multi-line description of the configuration.
+///
+string describeConfig(const Input& in, const SettingsPresets& presets) {
+    stringstream ss;
+    if (USE_PORTFOLIO) {
+        ss << "Portfolio cores == " << PORTFOLIO_CORES << '\n';
+        ss << "Portfolio time budget == " << PORTFOLIO_TIME_BUDGET << " seconds\n";
+        ss << portfolio.getConfig(Portfolio::sizeClassOf(in));
+    } else if (ENGINE == TABU_SEARCH) {
+        ss << tabuSettings;
+    } else if (ENGINE == LATE_ACCEPTANCE) {
+        ss << lahcSettings;
+    } else if (ENGINE == MEMETIC) {
+        ss << memeticSettings;
+    } else if (ENGINE == DYNASEARCH) {
+        ss << dynasearchSettings;
+    } else if (ENGINE == LARGE_NEIGHBOURHOOD) {
+        ss << lnsSettings;
+    } else if (ENGINE == VARIABLE_NEIGHBOURHOOD) {
+        ss << vnsSettings;
+    } else {
+        ss << presets.forInput(in);
+    }
+    return ss.str();
+}
+
 void solveAll() {
-    solveBatch(INPUT_DIR + LARGE_DIR, OUTPUT_DIR + LARGE_DIR, LOG_DIR, LARGE_PREFIX);
-    solveBatch(INPUT_DIR + MEDIUM_DIR, OUTPUT_DIR + MEDIUM_DIR, LOG_DIR, MEDIUM_PREFIX);
-    solveBatch(INPUT_DIR + SMALL_DIR, OUTPUT_DIR + SMALL_DIR, LOG_DIR, SMALL_PREFIX);
+    if (!USE_SHARDING) {
+        ResultCache cache(RESULT_CACHE);
+        bool seed = cache.size() == 0;
+        solveBatch(INPUT_DIR + LARGE_DIR, OUTPUT_DIR + LARGE_DIR, LOG_DIR, LARGE_PREFIX, cache, nullptr, seed);
+        solveBatch(INPUT_DIR + MEDIUM_DIR, OUTPUT_DIR + MEDIUM_DIR, LOG_DIR, MEDIUM_PREFIX, cache, nullptr, seed);
+        solveBatch(INPUT_DIR + SMALL_DIR, OUTPUT_DIR + SMALL_DIR, LOG_DIR, SMALL_PREFIX, cache, nullptr, seed);
+        return;
+    }
+
+    LeaseQueue queue(SHARD_QUEUE_DIR, LeaseQueue::defaultOwner(), SHARD_LEASE_SECONDS);
+    string shardDir = SHARD_DIR + queue.getOwner() + "/";
+    string logDir = shardDir + "log/";
+    for (const string& dir : {shardDir + LARGE_DIR, shardDir + MEDIUM_DIR, shardDir + SMALL_DIR, logDir}) {
+        makeDirectories(dir);
+    }
+    cout << "Solving shard " << queue.getOwner() << endl;
+    ResultCache cache(shardDir + "results.cache");
+    solveBatch(INPUT_DIR + LARGE_DIR, shardDir + LARGE_DIR, logDir, LARGE_PREFIX, cache, &queue, false);
+    solveBatch(INPUT_DIR + MEDIUM_DIR, shardDir + MEDIUM_DIR, logDir, MEDIUM_PREFIX, cache, &queue, false);
+    solveBatch(INPUT_DIR + SMALL_DIR, shardDir + SMALL_DIR, logDir, SMALL_PREFIX, cache, &queue, false);
+}
+
+///
+/// \brief Copies the best valid output of every instance among OUTPUT_DIR and the shards
+///        to OUTPUT_DIR, with its log.
+/// \param shards: Directories written by the processes of a sharded run.
+/// \param sizeDir: Subdirectory of the size class in OUTPUT_DIR and the shards.
+///
+void mergeBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix,
+                const vector<string>& shards, const string& sizeDir) {
+    for (int i = 1; i <= 300; ++i) {
+        string name = prefix + to_string(i);
+        Input in(inDir + name + INPUT_POSTFIX);
+        if (in.failed()) {
+            continue;
+        }
+        string error;
+        Output out(outDir + name + OUTPUT_POSTFIX, &error);
+        double bestProfit = error.empty() && out.isValidFor(in) ? out.evaluate(in) : -1.0;
+        double oldProfit = bestProfit;
+        string bestShard;
+        for (const string& shard : shards) {
+            error.clear();
+            Output candidate(shard + sizeDir + name + OUTPUT_POSTFIX, &error);
+            if (!error.empty() || !candidate.isValidFor(in) || candidate.evaluate(in) <= bestProfit) {
+                continue;
+            }
+            out = candidate;
+            bestProfit = candidate.evaluate(in);
+            bestShard = shard;
+        }
+        if (bestShard.empty()) {
+            continue;
+        }
+
+        cout << "Merged " << name << " from " << bestShard << ": " << max(0.0, oldProfit) << " -> " << bestProfit << endl;
+        out.writeFile(outDir + name + OUTPUT_POSTFIX);
+        string log;
+        if (readWholeFile(bestShard + "log/" + name + LOG_POSTFIX, log)) {
+            fstream fs(logDir + name + LOG_POSTFIX, fstream::out);
+            fs << log;
+        }
+    }
 }
 
-void fixBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix) {
+void mergeShards() {
+    vector<string> shards;
+    for (const string& owner : listDirectory(SHARD_DIR)) {
+        shards.push_back(SHARD_DIR + owner + "/");
+    }
+    mergeBatch(INPUT_DIR + LARGE_DIR, OUTPUT_DIR + LARGE_DIR, LOG_DIR, LARGE_PREFIX, shards, LARGE_DIR);
+    mergeBatch(INPUT_DIR + MEDIUM_DIR, OUTPUT_DIR + MEDIUM_DIR, LOG_DIR, MEDIUM_PREFIX, shards, MEDIUM_DIR);
+    mergeBatch(INPUT_DIR + SMALL_DIR, OUTPUT_DIR + SMALL_DIR, LOG_DIR, SMALL_PREFIX, shards, SMALL_DIR);
+
+    ResultCache cache(RESULT_CACHE);
+    for (const string& shard : shards) {
+        ResultCache shardCache(shard + "results.cache");
+        size_t stored = cache.mergeFrom(shardCache);
+        cout << "Merged " << stored << " of " << shardCache.size() << " cache records from " << shard << endl;
+    }
+}
+
+void fixBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix,
+              ResultCache& cache, const SettingsPresets& presets) {
     fstream fs;
     Input in;
     Output out;
@@ -146,6 +522,7 @@ void fixBatch(const string& inDir, const string& outDir, const string& logDir, c
             fs.close();
 
             // write output file
+            cache.store(ResultCache::key(in, describeConfig(in, presets)), out, gsProfit, 0.0);
             out.trim(in);
             out.writeFile(outputFileName);
         }
@@ -153,9 +530,77 @@ void fixBatch(const string& inDir, const string& outDir, const string& logDir, c
 }
 
 void fixAll() {
-    fixBatch(INPUT_DIR + LARGE_DIR, OUTPUT_DIR + LARGE_DIR, LOG_DIR, LARGE_PREFIX);
-    fixBatch(INPUT_DIR + MEDIUM_DIR, OUTPUT_DIR + MEDIUM_DIR, LOG_DIR, MEDIUM_PREFIX);
-    fixBatch(INPUT_DIR + SMALL_DIR, OUTPUT_DIR + SMALL_DIR, LOG_DIR, SMALL_PREFIX);
+    ResultCache cache(RESULT_CACHE);
+    SettingsPresets presets(settings);
+    presets.readFile(PRESET_FILE);
+    fixBatch(INPUT_DIR + LARGE_DIR, OUTPUT_DIR + LARGE_DIR, LOG_DIR, LARGE_PREFIX, cache, presets);
+    fixBatch(INPUT_DIR + MEDIUM_DIR, OUTPUT_DIR + MEDIUM_DIR, LOG_DIR, MEDIUM_PREFIX, cache, presets);
+    fixBatch(INPUT_DIR + SMALL_DIR, OUTPUT_DIR + SMALL_DIR, LOG_DIR, SMALL_PREFIX, cache, presets);
+}
+
+void polishBatch(const string& inDir, const string& outDir, const string& logDir, const string& prefix,
+                 ResultCache& cache, const SettingsPresets& presets, ThreadPool& pool) {
+    vector<double> oldProfits(300, 0.0);
+    vector<LocalSearch::Result> results(300);
+
+    // Polish one instance per task, so that workers pick up the next instance as soon as they finish.
+    pool.parallelFor(300, [&](int k) {
+        int i = k + 1;
+        Input in(inDir + prefix + to_string(i) + INPUT_POSTFIX);
+        string error;
+        Output out(outDir + prefix + to_string(i) + OUTPUT_POSTFIX, &error);
+
+        // skip if input or output file does not exist
+        if (in.failed() || !error.empty() || !out.isValidFor(in)) {
+            return;
+        }
+        oldProfits[k] = out.evaluate(in);
+        results[k] = LocalSearch(in).polish(out);
+        if (results[k].profit <= oldProfits[k] + POLISH_GAIN_THRESH) {
+            return;
+        }
+
+        // write log file
+        fstream fs(logDir + prefix + to_string(i) + ".polish" + LOG_POSTFIX, fstream::out);
+        fs << results[k].profit << endl;
+        fs << results[k].output << endl;
+        fs << "Profit before polishing == " << oldProfits[k] << '\n';
+        fs << "Improving moves == " << results[k].moves << '\n';
+        fs.close();
+
+        // write output file
+        cache.store(ResultCache::key(in, describeConfig(in, presets)), results[k].output, results[k].profit, 0.0);
+        results[k].output.trim(in);
+        results[k].output.writeFile(outDir + prefix + to_string(i) + OUTPUT_POSTFIX);
+    });
+
+    for (int k = 0; k < 300; ++k) {
+        if (results[k].profit > oldProfits[k] + POLISH_GAIN_THRESH) {
+            cout << "Polished " << prefix << k + 1 << ": " << oldProfits[k] << " -> " << results[k].profit << endl;
+        }
+    }
+}
+
+void polishAll() {
+    ThreadPool pool(POLISH_THREADS);
+    ResultCache cache(RESULT_CACHE);
+    SettingsPresets presets(settings);
+    presets.readFile(PRESET_FILE);
+    polishBatch(INPUT_DIR + LARGE_DIR, OUTPUT_DIR + LARGE_DIR, LOG_DIR, LARGE_PREFIX, cache, presets, pool);
+    polishBatch(INPUT_DIR + MEDIUM_DIR, OUTPUT_DIR + MEDIUM_DIR, LOG_DIR, MEDIUM_PREFIX, cache, presets, pool);
+    polishBatch(INPUT_DIR + SMALL_DIR, OUTPUT_DIR + SMALL_DIR, LOG_DIR, SMALL_PREFIX, cache, presets, pool);
+}
+
+///
+/// \brief Returns the profit of the output file of an Input.
+/// \param in: Problem is specified by this Input.
+/// \param outputFileName: Directory to the output file.
+/// \return Profit of the output, -1 if the file is missing or not valid for the Input.
+///
+double existingProfit(const Input& in, const string& outputFileName) {
+    string error;
+    Output out(outputFileName, &error);
+    return error.empty() && out.isValidFor(in) ? out.evaluate(in) : -1.0;
 }
 
 
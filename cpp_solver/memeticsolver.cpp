@@ -0,0 +1,299 @@
+#include "memeticsolver.h"
+#include "greedysolver.h"
+#include <algorithm>
+#include <numeric>
+
+MemeticSolver::MemeticSolver() {}
+
+///
+/// \brief Initializes a solver instance using the Input.
+/// \param in: Problem is specified by this Input.
+/// \param s: Settings used by run().
+///
+MemeticSolver::MemeticSolver(const Input &in, const Settings &s) {
+    input = in;
+    settings = s;
+}
+
+///
+/// \brief Solves the problem with the seed and settings specified. The initial
+///        population holds the best greedy sequence and random permutations, all
+///        improved by local search. Offspring are bred on NUM_THREADS threads.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param s: Settings for the solver.
+/// \return The best task sequence found by the algorithm
+///         specified by an untrimmed Output.
+///
+Output MemeticSolver::solve(int seed, Settings s) {
+    return evolve(seed, s, NUM_THREADS);
+}
+
+///
+/// \brief Returns the name of the solver.
+/// \return Name of the solver.
+///
+std::string MemeticSolver::name() const {
+    return "Memetic";
+}
+
+///
+/// \brief Evolves populations with the settings given at construction until the
+///        control asks to stop, starting a new population whenever one stagnates.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param numThreads: Number of threads breeding offspring.
+/// \param control: Deadline and incumbent shared with other solvers.
+/// \return The best task sequence found by this solver.
+///
+Output MemeticSolver::run(int seed, int numThreads, SolveControl &control) {
+    Output best = evolve(seed, settings, numThreads, &control);
+    double maxProfit = best.evaluate(input);
+    for (int restart = 1; !control.shouldStop(); ++restart) {
+        Output out = evolve(seed + restart * numThreads, settings, numThreads, &control);
+        double profit = out.evaluate(input);
+        if (profit > maxProfit) {
+            maxProfit = profit;
+            best = out;
+        }
+    }
+    return best;
+}
+
+///
+/// \brief Evolves a single population until it stagnates.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param s: Settings for the solver.
+/// \param numThreads: Number of threads breeding offspring.
+/// \param control: If specified, evolution stops early when the control asks to stop.
+///        The best sequence of every generation is offered to it, and a better incumbent
+///        replaces the worst parent.
+/// \return The best task sequence in the final population.
+///
+Output MemeticSolver::evolve(int seed, const Settings &s, int numThreads, SolveControl *control) {
+    int n = input.size();
+    int populationSize = std::max(s.populationSize, 2);
+    int localSearchMoves = static_cast<int>(s.localSearchFactor * n * n);
+    if (n < 2) {
+        GreedySolver gs(input);
+        return gs.solve();
+    }
+
+    // Allocate every buffer used by the generations up front.
+    sequences.assign(2 * populationSize, std::vector<int>(n));
+    profits.assign(2 * populationSize, 0.0);
+    order.resize(2 * populationSize);
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<Worker> workers(numThreads);
+    for (int tid = 0; tid < numThreads; ++tid) {
+        workers[tid].gen.seed(seed + tid);
+        workers[tid].state = ScheduleState(input);
+        workers[tid].used.assign(n, 0);
+    }
+    ThreadPool pool(numThreads);
+
+    // Initial population
+    GreedySolver gs(input);
+    workers[0].state.assign(gs.solve().getSchedule());
+    sequences[0] = workers[0].state.getSequence();
+    for (int k = 1; k < populationSize; ++k) {
+        std::iota(sequences[k].begin(), sequences[k].end(), 0);
+        std::shuffle(sequences[k].begin(), sequences[k].end(), workers[0].gen);
+    }
+    pool.parallelFor(numThreads, [&](int tid) {
+        for (int k = tid; k < populationSize; k += numThreads) {
+            profits[k] = improve(sequences[k], workers[tid], localSearchMoves);
+        }
+    });
+    select(populationSize);
+    if (control) {
+        exchange(*control, workers[0], populationSize);
+    }
+
+    if (s.verbose) {
+        std::cout << "---------------- MEMETIC SOLVE BEGIN ----------------\n";
+        std::cout << "seed == " << seed << '\n';
+        std::cout << "Printing Parameters... \n" << s;
+        std::cout << "Input size == " << n << '\n';
+        std::cout << "Initial best profit == " << profits[order[0]] << '\n';
+    }
+
+    double lastBestProfit = profits[order[0]];
+    int stagnation = 0;
+    int generation = 0;
+    for (; generation < s.maxGenerations && stagnation < s.maxStagnation; ++generation) {
+        if (control && control->shouldStop()) {
+            break;
+        }
+        pool.parallelFor(numThreads, [&](int tid) {
+            for (int k = tid; k < populationSize; k += numThreads) {
+                breed(order[populationSize + k], workers[tid], localSearchMoves);
+            }
+        });
+        select(populationSize);
+        if (control) {
+            exchange(*control, workers[0], populationSize);
+        }
+
+        double bestProfit = profits[order[0]];
+        if (bestProfit - lastBestProfit < PROFIT_GAIN_THRESH) {
+            ++stagnation;
+        } else {
+            stagnation = 0;
+        }
+        lastBestProfit = bestProfit;
+        if (s.verbose && generation % s.printPeriod == 0) {
+            std::cout << "Generation " << generation << ": best profit == " << bestProfit
+                      << ", worst parent profit == " << profits[order[populationSize - 1]] << '\n';
+        }
+    }
+    if (s.verbose) {
+        std::cout << "STOPPED AFTER " << generation << " GENERATIONS.\n";
+        std::cout << "Final profit == " << profits[order[0]] << '\n';
+        std::cout << "---------------- MEMETIC SOLVE DONE ----------------\n";
+    }
+    return Output(sequences[order[0]]);
+}
+
+///
+/// \brief Offers the best parent to the control, and replaces the worst parent by
+///        the incumbent if the incumbent is more profitable than every parent.
+/// \param control: Deadline and incumbent shared with other solvers.
+/// \param worker: Scratch space used to complete the incumbent to a full sequence.
+/// \param populationSize: Number of parents.
+///
+void MemeticSolver::exchange(SolveControl &control, Worker &worker, int populationSize) {
+    int best = order[0];
+    if (profits[best] > control.getIncumbentProfit()) {
+        control.offer(Output(sequences[best]), profits[best]);
+    } else if (control.getIncumbentProfit() > profits[best]) {
+        Output incumbent;
+        double profit;
+        if (control.getIncumbent(incumbent, profit)) {
+            int worst = order[populationSize - 1];
+            worker.state.assign(incumbent.getSchedule());
+            std::copy(worker.state.getSequence().begin(), worker.state.getSequence().end(), sequences[worst].begin());
+            profits[worst] = worker.state.getProfit();
+            std::rotate(order.begin(), order.begin() + populationSize - 1, order.begin() + populationSize);
+        }
+    }
+}
+
+///
+/// \brief Overwrites the buffer sequences[child] with the improved offspring of two
+///        parents picked by binary tournament.
+/// \param child: Index of the offspring buffer.
+/// \param worker: Scratch space of the calling thread.
+/// \param localSearchMoves: Number of local search moves applied to the offspring.
+///
+void MemeticSolver::breed(int child, Worker &worker, int localSearchMoves) {
+    int populationSize = static_cast<int>(order.size() / 2);
+    int parent1 = tournament(worker.gen, populationSize);
+    int parent2 = tournament(worker.gen, populationSize);
+    crossover(sequences[parent1], sequences[parent2], sequences[child], worker);
+    profits[child] = improve(sequences[child], worker, localSearchMoves);
+}
+
+///
+/// \brief Order crossover. A random slice of the first parent is copied to the same
+///        positions of the child, and the remaining positions are filled with the other
+///        tasks in the order they appear in the second parent.
+/// \param parent1: First parent.
+/// \param parent2: Second parent.
+/// \param child: Assigned to be the offspring, must have the size of the parents.
+/// \param worker: Scratch space of the calling thread.
+///
+void MemeticSolver::crossover(const std::vector<int> &parent1, const std::vector<int> &parent2,
+                              std::vector<int> &child, Worker &worker) const {
+    int n = static_cast<int>(parent1.size());
+    std::uniform_int_distribution<int> positionDist(0, n - 1);
+    int lo = positionDist(worker.gen);
+    int hi = positionDist(worker.gen);
+    if (lo > hi) {
+        std::swap(lo, hi);
+    }
+    std::fill(worker.used.begin(), worker.used.end(), 0);
+    for (int k = lo; k <= hi; ++k) {
+        child[k] = parent1[k];
+        worker.used[parent1[k]] = 1;
+    }
+    int k = 0;
+    for (int task : parent2) {
+        if (worker.used[task]) {
+            continue;
+        }
+        if (k == lo) {
+            k = hi + 1;
+        }
+        child[k++] = task;
+    }
+}
+
+///
+/// \brief Randomized first-improvement local search. Each move is a swap or insertion
+///        with one index inside the scheduled part of the sequence and is applied
+///        only if it increases the profit.
+/// \param sequence: Sequence to improve in place.
+/// \param worker: Scratch space of the calling thread.
+/// \param localSearchMoves: Number of moves to try.
+/// \return Profit of the improved sequence.
+///
+double MemeticSolver::improve(std::vector<int> &sequence, Worker &worker, int localSearchMoves) const {
+    ScheduleState& state = worker.state;
+    state.assign(sequence);
+    int n = state.size();
+    std::uniform_int_distribution<int> uniformTaskNumDist(0, n - 1);
+    for (int move = 0; move < localSearchMoves; ++move) {
+        int index1 = std::uniform_int_distribution<int>(0, std::min(state.cutoff(), n - 1))(worker.gen);
+        int index2 = uniformTaskNumDist(worker.gen);
+        if (index1 == index2) {
+            continue;
+        }
+        if (move % 2 == 0) {
+            if (state.swapDelta(index1, index2) > 0) {
+                state.applySwap(index1, index2);
+            }
+        } else {
+            if (move % 4 == 3) {    // alternate the direction of insertions
+                std::swap(index1, index2);
+            }
+            if (state.insertDelta(index1, index2) > 0) {
+                state.applyInsert(index1, index2);
+            }
+        }
+    }
+    std::copy(state.getSequence().begin(), state.getSequence().end(), sequence.begin());
+    state.refresh();
+    return state.getProfit();
+}
+
+///
+/// \brief Binary tournament selection among the current parents.
+/// \param gen: Random generator.
+/// \param populationSize: Number of parents.
+/// \return Index of the buffer of the selected parent.
+///
+int MemeticSolver::tournament(std::mt19937_64 &gen, int populationSize) const {
+    std::uniform_int_distribution<int> parentDist(0, populationSize - 1);
+    int a = order[parentDist(gen)];
+    int b = order[parentDist(gen)];
+    return profits[a] >= profits[b] ? a : b;
+}
+
+///
+/// \brief Keeps the best populationSize sequences among parents and offspring as the
+///        next parents. Sequences with the same profit as a better one are treated as
+///        duplicates and ranked last, which keeps the population diverse. Buffers that
+///        are not selected become the offspring buffers of the next generation.
+/// \param populationSize: Number of parents.
+///
+void MemeticSolver::select(int populationSize) {
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return profits[a] > profits[b] || (profits[a] == profits[b] && a < b);
+    });
+    // Compact the distinct profits to the front, duplicates end up behind them.
+    int kept = 1;
+    for (int k = 1; k < static_cast<int>(order.size()) && kept < populationSize; ++k) {
+        if (profits[order[k]] != profits[order[kept - 1]]) {
+            std::swap(order[kept++], order[k]);
+        }
+    }
+}
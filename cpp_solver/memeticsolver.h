@@ -0,0 +1,92 @@
+#ifndef MEMETICSOLVER_H
+#define MEMETICSOLVER_H
+#include "input.h"
+#include "output.h"
+#include "schedulestate.h"
+#include "solver.h"
+#include "threadpool.h"
+#include <random>
+
+///
+/// \brief Memetic solver. A population of task sequences is evolved with order crossover,
+///        which keeps the relative order of the tasks taken from the second parent, and
+///        every offspring is improved by a short randomized local search. Offspring are
+///        created and improved in parallel, one worker per thread with its own random
+///        generator, so results only depend on the seed. All population buffers are
+///        allocated once, so a generation does not allocate.
+///
+class MemeticSolver : public Solver
+{
+public:
+    static const int NUM_THREADS = 8;
+    struct Settings {
+        int populationSize;         // Number of sequences kept between generations.
+        int maxGenerations;         // Maximum number of generations.
+        int maxStagnation;          // Stop after this many consecutive generations without profit gain.
+        double localSearchFactor;   // Number of local search moves per offspring == localSearchFactor * numTasks * numTasks.
+        bool verbose;               // Prints a summary of each generation if set to true.
+        int printPeriod;            // Print a summary every this number of generations.
+
+        Settings(int populationSize = 40,
+                 int maxGenerations = 1000,
+                 int maxStagnation = 50,
+                 double localSearchFactor = 0.5,
+                 bool verbose = false,
+                 int printPeriod = 1) {
+            this->populationSize = populationSize;
+            this->maxGenerations = maxGenerations;
+            this->maxStagnation = maxStagnation;
+            this->localSearchFactor = localSearchFactor;
+            this->verbose = verbose;
+            this->printPeriod = printPeriod;
+        }
+
+        friend std::ostream& operator <<(std::ostream& out, const Settings& s) {
+            out << "GLOBAL NUM_THREADS == " << MemeticSolver::NUM_THREADS << '\n';
+            out << "Population size == " << s.populationSize << '\n';
+            out << "Max generations == " << s.maxGenerations << '\n';
+            out << "Max generations with no profit gain == " << s.maxStagnation << '\n';
+            out << "Local search factor == " << s.localSearchFactor << '\n';
+            return out;
+        }
+    };
+
+private:
+    ///
+    /// \brief Scratch space owned by one worker thread.
+    ///
+    struct Worker {
+        std::mt19937_64 gen;
+        ScheduleState state;
+        std::vector<char> used;
+    };
+
+    Input input;
+    Settings settings;
+    const double PROFIT_GAIN_THRESH = 1e-3;     // No profit is considered gained if less than this value.
+
+    std::vector<std::vector<int>> sequences;    // Parents followed by offspring, 2 * populationSize buffers.
+    std::vector<double> profits;                // profits[k] == profit of sequences[k].
+    std::vector<int> order;                     // order[0..populationSize) index the parents, the rest the offspring.
+
+public:
+    MemeticSolver();
+    MemeticSolver(const Input& in, const Settings& s = Settings());
+
+    Output solve(int seed = 0, Settings s = Settings());
+
+    std::string name() const override;
+    Output run(int seed, int numThreads, SolveControl& control) override;
+
+private:
+    Output evolve(int seed, const Settings& s, int numThreads, SolveControl* control = nullptr);
+    void exchange(SolveControl& control, Worker& worker, int populationSize);
+    void breed(int child, Worker& worker, int localSearchMoves);
+    void crossover(const std::vector<int>& parent1, const std::vector<int>& parent2,
+                   std::vector<int>& child, Worker& worker) const;
+    double improve(std::vector<int>& sequence, Worker& worker, int localSearchMoves) const;
+    int tournament(std::mt19937_64& gen, int populationSize) const;
+    void select(int populationSize);
+};
+
+#endif // MEMETICSOLVER_H
@@ -8,6 +8,29 @@ NaiveSolver::NaiveSolver(const Input& in) {
 }
 
 Output NaiveSolver::solve(bool verbose) const {
+    return search(verbose, nullptr);
+}
+
+///
+/// \brief Returns the name of the solver.
+/// \return Name of the solver.
+///
+std::string NaiveSolver::name() const {
+    return "Naive";
+}
+
+///
+/// \brief Enumerates permutations until all are checked or the control asks to stop.
+///        Only practical for very small inputs. seed and numThreads are ignored.
+/// \return Schedule with max profit among the permutations checked.
+///
+Output NaiveSolver::run(int, int, SolveControl &control) {
+    Output best = search(false, &control);
+    control.offer(best, best.evaluate(input));
+    return best;
+}
+
+Output NaiveSolver::search(bool verbose, SolveControl *control) const {
     Output best;
     double maxProfit = 0;
     std::vector<int> schedule;
@@ -32,6 +55,8 @@ Output NaiveSolver::solve(bool verbose) const {
                 std::cout << "New profit == " << profit << " <= current max profit == " << maxProfit << ", no update needed.\n\n";
             }
         }
-    } while (std::next_permutation(schedule.begin(), schedule.end()));
+        ++iter;
+    } while (std::next_permutation(schedule.begin(), schedule.end())
+             && !(control && iter % 4096 == 0 && control->shouldStop()));
     return best;
 }
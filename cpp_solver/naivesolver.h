@@ -2,8 +2,9 @@
 #define NAIVESOLVER_H
 #include "input.h"
 #include "output.h"
+#include "solver.h"
 
-class NaiveSolver
+class NaiveSolver : public Solver
 {
 private:
     Input input;
@@ -13,6 +14,12 @@ public:
     NaiveSolver(const Input& in);
 
     Output solve(bool verbose = false) const;
+
+    std::string name() const override;
+    Output run(int seed, int numThreads, SolveControl& control) override;
+
+private:
+    Output search(bool verbose, SolveControl* control) const;
 };
 
 #endif // NAIVESOLVER_H
@@ -1,4 +1,6 @@
 #include "output.h"
+#include "filereader.h"
+#include "profit.h"
 #include <iostream>
 #include <fstream>
 #include <cmath>
@@ -14,17 +16,51 @@ Output::Output(const std::vector<int> &schedule) {
 }
 
 ///
-/// \brief Reads an Output from a file.
+/// \brief Reads an Output from a file in a single pass. Reading stops at the first
+///        token that is not an integer, keeping the tasks read before it.
 /// \param fileName: Directory to the Output file.
+/// \param error: If specified, assigned "file:line:column: message" if the file cannot
+///        be opened or is malformed, and an empty string otherwise.
 ///
-Output::Output(const std::string &fileName) {
-    std::fstream file(fileName, std::fstream::in);
+Output::Output(const std::string &fileName, std::string *error) {
+    FileBuffer file(fileName);
+    if (error) {
+        error->clear();
+    }
+    if (!file.isOpen()) {
+        if (error) {
+            *error = fileName + ": cannot open file";
+        }
+        return;
+    }
+    TextScanner scanner(file.data(), file.size(), fileName);
+    taskSchedule.reserve(file.size() / 2);
     int task;
-    while (!file.eof()) {
-        file >> task;
+    while (!scanner.atEnd()) {
+        if (!scanner.readInt(task)) {
+            if (error) {
+                *error = scanner.where() + ": expected a task index";
+            }
+            break;
+        }
         taskSchedule.push_back(task - 1); // -1 to convert to 0-indexed
     }
-    file.close();
+}
+
+///
+/// \brief Returns the number of tasks in the sequence.
+/// \return Length of the task sequence.
+///
+size_t Output::size() const {
+    return taskSchedule.size();
+}
+
+///
+/// \brief Get a constant reference to the task sequence.
+/// \return A constant reference to the 0-indexed task sequence.
+///
+const std::vector<int> &Output::getSchedule() const {
+    return taskSchedule;
 }
 
 ///
@@ -44,7 +80,7 @@ bool Output::swapTasks(size_t index1, size_t index2) {
 }
 
 ///
-/// \brief Trims the Output to fit the gloabl deadline specified by project.
+/// \brief Trims the Output to fit the gloabl deadline (horizon) of the Input.
 ///        An Input must be specified for durations of each task.
 /// \param input: Problem is specified by this Input.
 /// \return True if the Output is valid for the Input, false otherwise.
@@ -56,7 +92,7 @@ bool Output::trim(const Input &input) {
             return false;
         }
         time += input.getDuration(taskSchedule[i]);
-        if (time > 1440) {  // tasks from index i to the end are invalid
+        if (time > input.getHorizon()) {  // tasks from index i to the end are invalid
             taskSchedule.resize(i);
             return true;
         }
@@ -77,7 +113,7 @@ bool Output::isValidFor(const Input& input) const {
             return false;
         }
         time += input.getDuration(i);
-        if (time > 1440) {
+        if (time > input.getHorizon()) {
             return false;
         }
     }
@@ -96,12 +132,12 @@ double Output::evaluate(const Input &input) const {
     int minutesLate;
     for (int i : taskSchedule) {
         time += input.getDuration(i);
-        if (time > 1440) {
+        if (time > input.getHorizon()) {
             return res;
         }
         minutesLate = time - input.getDeadline(i);
         if (minutesLate > 0) {
-            res += input.getProfit(i) * exp(-0.017 * minutesLate);
+            res += input.getProfit(i) * exp(-LATE_DECAY_RATE * minutesLate);
         } else {
             res += input.getProfit(i);
         }
@@ -109,6 +145,25 @@ double Output::evaluate(const Input &input) const {
     return res;
 }
 
+///
+/// \brief Returns the profit of the current task schedule for the given Input
+///        in the fixed-point representation of FixedProfit.
+/// \param input: Problem is specified by this Input.
+/// \return Profit of current task schedule, in units of 1 / FixedProfit::UNIT.
+///
+long long Output::evaluateFixed(const Input &input) const {
+    long long res = 0;
+    int time = 0;
+    for (int i : taskSchedule) {
+        time += input.getDuration(i);
+        if (time > input.getHorizon()) {
+            return res;
+        }
+        res += FixedProfit::gain(input, i, time - input.getDeadline(i));
+    }
+    return res;
+}
+
 ///
 /// \brief Writes the Output to a file.
 /// \param fileName: Directory to the Output file. Overwrites
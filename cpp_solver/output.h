@@ -1,13 +1,14 @@
 #ifndef OUTPUT_H
 #define OUTPUT_H
 #include <iostream>
+#include <string>
 #include <vector>
 #include "input.h"
 
 ///
 /// \brief An output is a solution to the problem specified by a sequence
 ///        of task indices. The project spec does not allow tasks to be
-///        assigned after the global deadline (1440 by default). However,
+///        assigned after the global deadline (Input::getHorizon, 1440 by default). However,
 ///        tasks are allowed to exist in this class even if they exceeds
 ///        the above time limit since the Output does not know anything
 ///        about Input. When evaluating the profit of an Output, an Input
@@ -24,13 +25,17 @@ private:
 public:
     Output();
     Output(const std::vector<int>& schedule);
-    Output(const std::string& fileName);
+    Output(const std::string& fileName, std::string* error = nullptr);
+
+    size_t size() const;
+    const std::vector<int>& getSchedule() const;
 
     bool swapTasks(size_t index1, size_t index2);
     bool trim(const Input& input);
 
     bool isValidFor(const Input& input) const;
     double evaluate(const Input& input) const;
+    long long evaluateFixed(const Input& input) const;
 
     void writeFile(const std::string& fileName);
     friend std::ostream& operator <<(std::ostream& o, const Output& output);
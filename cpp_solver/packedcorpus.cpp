@@ -0,0 +1,248 @@
+#include "packedcorpus.h"
+#include "hash.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+static const char MAGIC[8] = {'C', 'S', '1', '7', '0', 'P', 'K', '\0'};
+
+///
+/// \brief Rounds a size up to a multiple of 8 bytes.
+///
+static uint64_t align8(uint64_t size) {
+    return (size + 7) & ~uint64_t(7);
+}
+
+///
+/// \brief Maps a packed corpus file and checks its header and index. The content
+///        hash is not checked, see verify().
+/// \param fileName: Directory to the packed corpus.
+///
+PackedCorpus::PackedCorpus(const std::string &fileName) : file(fileName) {
+    if (!file.isOpen()) {
+        error = fileName + ": cannot open file";
+        return;
+    }
+    if (file.size() < sizeof(Header)) {
+        error = fileName + ": too small to be a packed corpus";
+        return;
+    }
+    const Header* h = reinterpret_cast<const Header*>(file.data());
+    if (std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error = fileName + ": not a packed corpus";
+    } else if (h->byteOrder != BYTE_ORDER_MARK) {
+        error = fileName + ": written on a machine with a different byte order";
+    } else if (h->version != VERSION) {
+        error = fileName + ": unsupported version " + std::to_string(h->version);
+    } else if (h->fileSize != file.size()
+               || h->numInstances > (file.size() - sizeof(Header)) / sizeof(IndexEntry)) {
+        error = fileName + ": truncated";
+    }
+    if (!error.empty()) {
+        return;
+    }
+    const IndexEntry* entries = reinterpret_cast<const IndexEntry*>(file.data() + sizeof(Header));
+    for (uint64_t k = 0; k < h->numInstances; ++k) {
+        const IndexEntry& e = entries[k];
+        // Compared against the room left after the offset, so that a corrupt offset cannot overflow.
+        uint64_t size = file.size();
+        uint64_t taskBytes = static_cast<uint64_t>(e.numTasks) * sizeof(TaskRecord);
+        uint64_t outputBytes = static_cast<uint64_t>(e.outputLength) * sizeof(int32_t);
+        bool inFile = e.offset <= size && taskBytes <= size - e.offset && outputBytes <= size - e.offset - taskBytes;
+        if (e.offset % 8 != 0 || !inFile || e.name[sizeof(e.name) - 1] != '\0') {
+            error = fileName + ": corrupt index entry " + std::to_string(k);
+            return;
+        }
+    }
+    header = h;
+    index = entries;
+}
+
+///
+/// \brief Returns whether the file was mapped and its header and index are consistent.
+/// \return True if the corpus can be read.
+///
+bool PackedCorpus::isOpen() const {
+    return header != nullptr;
+}
+
+///
+/// \brief Returns why the corpus could not be opened.
+/// \return Error message, empty if the corpus is open.
+///
+const std::string &PackedCorpus::getError() const {
+    return error;
+}
+
+///
+/// \brief Recomputes the content hash, which reads the whole file.
+/// \return True if the content matches the hash in the header.
+///
+bool PackedCorpus::verify() const {
+    return isOpen() && hashBytes(file.data() + sizeof(Header), file.size() - sizeof(Header)) == header->hash;
+}
+
+///
+/// \brief Returns the number of instances.
+/// \return Number of instances, zero if the corpus is not open.
+///
+int PackedCorpus::size() const {
+    return isOpen() ? static_cast<int>(header->numInstances) : 0;
+}
+
+///
+/// \brief Looks up an instance by name.
+/// \param name: Name of the instance, e.g. "large-17".
+/// \return Index of the instance, -1 if there is no such instance.
+///
+int PackedCorpus::find(const std::string &name) const {
+    const IndexEntry* first = index;
+    const IndexEntry* last = index + size();
+    const IndexEntry* it = std::lower_bound(first, last, name, [](const IndexEntry& e, const std::string& key) {
+        return std::strcmp(e.name, key.c_str()) < 0;
+    });
+    return it != last && name == it->name ? static_cast<int>(it - first) : -1;
+}
+
+const char *PackedCorpus::name(int k) const {
+    return index[k].name;
+}
+
+///
+/// \brief Returns the hash of the tasks of an instance, equal to hashTasks of its Input.
+/// \param k: Index of the instance.
+/// \return Content hash of the instance.
+///
+uint64_t PackedCorpus::inputHash(int k) const {
+    return index[k].inputHash;
+}
+
+int PackedCorpus::numTasks(int k) const {
+    return static_cast<int>(index[k].numTasks);
+}
+
+///
+/// \brief Returns the tasks of an instance in place, without copying.
+/// \param k: Index of the instance.
+/// \return Pointer to numTasks(k) records inside the mapped file.
+///
+const PackedCorpus::TaskRecord *PackedCorpus::tasks(int k) const {
+    return reinterpret_cast<const TaskRecord*>(file.data() + index[k].offset);
+}
+
+int PackedCorpus::outputLength(int k) const {
+    return static_cast<int>(index[k].outputLength);
+}
+
+///
+/// \brief Returns the Output of an instance in place, without copying.
+/// \param k: Index of the instance.
+/// \return Pointer to outputLength(k) 0-indexed tasks inside the mapped file.
+///
+const int32_t *PackedCorpus::outputTasks(int k) const {
+    return reinterpret_cast<const int32_t*>(file.data() + index[k].offset + index[k].numTasks * sizeof(TaskRecord));
+}
+
+///
+/// \brief Builds the Input of an instance from its records.
+/// \param k: Index of the instance.
+/// \return Input with the tasks of the instance.
+///
+Input PackedCorpus::input(int k) const {
+    int n = numTasks(k);
+    const TaskRecord* records = tasks(k);
+    std::vector<int> deadlines(n);
+    std::vector<int> durations(n);
+    std::vector<double> profits(n);
+    for (int i = 0; i < n; ++i) {
+        deadlines[i] = records[i].deadline;
+        durations[i] = records[i].duration;
+        profits[i] = records[i].profit;
+    }
+    return Input(deadlines, durations, profits);
+}
+
+///
+/// \brief Builds the Output of an instance.
+/// \param k: Index of the instance.
+/// \return Output of the instance, empty if it was packed without one.
+///
+Output PackedCorpus::output(int k) const {
+    const int32_t* p = outputTasks(k);
+    return Output(std::vector<int>(p, p + outputLength(k)));
+}
+
+///
+/// \brief Packs instances into a file.
+/// \param fileName: Directory to the packed corpus. Overwrites if file already exists.
+/// \param entries: Instances to pack, names must be unique and shorter than 32 characters.
+/// \return False if a name is too long or duplicated, or the file cannot be written.
+///
+bool PackedCorpus::write(const std::string &fileName, std::vector<Entry> entries) {
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+    for (size_t k = 0; k < entries.size(); ++k) {
+        if (entries[k].name.size() >= sizeof(IndexEntry::name) || (k > 0 && entries[k].name == entries[k - 1].name)) {
+            return false;
+        }
+    }
+
+    std::vector<char> buffer(sizeof(Header) + entries.size() * sizeof(IndexEntry), 0);
+    std::vector<IndexEntry> index(entries.size());
+    for (size_t k = 0; k < entries.size(); ++k) {
+        std::vector<TaskRecord> records = toRecords(entries[k].input);
+        const std::vector<int>& schedule = entries[k].output.getSchedule();
+        IndexEntry& e = index[k];
+        std::memset(&e, 0, sizeof(e));
+        std::strcpy(e.name, entries[k].name.c_str());
+        e.numTasks = static_cast<uint32_t>(records.size());
+        e.outputLength = static_cast<uint32_t>(schedule.size());
+        e.offset = buffer.size();
+        e.inputHash = hashBytes(records.data(), records.size() * sizeof(TaskRecord));
+
+        const char* recordBytes = reinterpret_cast<const char*>(records.data());
+        buffer.insert(buffer.end(), recordBytes, recordBytes + records.size() * sizeof(TaskRecord));
+        for (int task : schedule) {
+            int32_t value = task;
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+        }
+        buffer.resize(align8(buffer.size()), 0);
+    }
+    if (!index.empty()) {
+        std::memcpy(buffer.data() + sizeof(Header), index.data(), index.size() * sizeof(IndexEntry));
+    }
+
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.byteOrder = BYTE_ORDER_MARK;
+    h.numInstances = entries.size();
+    h.fileSize = buffer.size();
+    h.hash = hashBytes(buffer.data() + sizeof(Header), buffer.size() - sizeof(Header));
+    std::memcpy(buffer.data(), &h, sizeof(h));
+
+    std::ofstream fs(fileName, std::ofstream::binary);
+    fs.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return fs.good();
+}
+
+///
+/// \brief Returns the content hash of an Input, as stored in the index of a packed corpus.
+/// \param input: Problem is specified by this Input.
+/// \return Hash of the task records of the Input.
+///
+uint64_t PackedCorpus::hashTasks(const Input &input) {
+    std::vector<TaskRecord> records = toRecords(input);
+    return hashBytes(records.data(), records.size() * sizeof(TaskRecord));
+}
+
+std::vector<PackedCorpus::TaskRecord> PackedCorpus::toRecords(const Input &input) {
+    std::vector<TaskRecord> records(input.size());
+    for (int i = 0; i < input.size(); ++i) {
+        records[i].deadline = input.getDeadline(i);
+        records[i].duration = input.getDuration(i);
+        records[i].profit = input.getProfit(i);
+    }
+    return records;
+}
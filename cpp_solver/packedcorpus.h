@@ -0,0 +1,89 @@
+#ifndef PACKEDCORPUS_H
+#define PACKEDCORPUS_H
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "filereader.h"
+#include "input.h"
+#include "output.h"
+
+///
+/// \brief A whole corpus of instances, and optionally an Output for each of them,
+///        packed into one binary file. The file is memory-mapped and read in place:
+///        looking up an instance is a binary search over the index and its tasks are
+///        fixed-width records, so nothing is parsed. The layout is
+///            Header | IndexEntry[numInstances] sorted by name | per instance:
+///            TaskRecord[numTasks] followed by int32_t[outputLength] (0-indexed tasks)
+///        with every section aligned to 8 bytes. Numbers are stored in the byte order
+///        of the machine that wrote the file; a file written with another byte order
+///        is rejected. The hash of the header covers everything after the header.
+///
+class PackedCorpus
+{
+public:
+    struct Header {
+        char magic[8];          // "CS170PK\0"
+        uint32_t version;
+        uint32_t byteOrder;     // BYTE_ORDER_MARK as written by the packing machine.
+        uint64_t numInstances;
+        uint64_t fileSize;
+        uint64_t hash;          // hashBytes of everything after the header.
+        uint64_t reserved[3];
+    };
+
+    struct IndexEntry {
+        char name[32];          // Null-terminated instance name, e.g. "large-17".
+        uint32_t numTasks;
+        uint32_t outputLength;  // Zero if the instance has no Output.
+        uint64_t offset;        // Offset of the first TaskRecord from the beginning of the file.
+        uint64_t inputHash;     // hashBytes of the TaskRecords, identifies the instance by content.
+    };
+
+    struct TaskRecord {
+        int32_t deadline;
+        int32_t duration;
+        double profit;
+    };
+
+    struct Entry {
+        std::string name;
+        Input input;
+        Output output;          // May be empty.
+    };
+
+    static const uint32_t VERSION = 1;
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+private:
+    FileBuffer file;
+    const Header* header = nullptr;
+    const IndexEntry* index = nullptr;
+    std::string error;
+
+public:
+    PackedCorpus(const std::string& fileName);
+
+    bool isOpen() const;
+    const std::string& getError() const;
+    bool verify() const;
+
+    int size() const;
+    int find(const std::string& name) const;
+    const char* name(int k) const;
+    uint64_t inputHash(int k) const;
+    int numTasks(int k) const;
+    const TaskRecord* tasks(int k) const;
+    int outputLength(int k) const;
+    const int32_t* outputTasks(int k) const;
+
+    Input input(int k) const;
+    Output output(int k) const;
+
+    static bool write(const std::string& fileName, std::vector<Entry> entries);
+    static uint64_t hashTasks(const Input& input);
+
+private:
+    static std::vector<TaskRecord> toRecords(const Input& input);
+};
+
+#endif // PACKEDCORPUS_H
@@ -0,0 +1,252 @@
+#include "portfolio.h"
+#include "greedysolver.h"
+#include "naivesolver.h"
+#include <thread>
+
+///
+/// \brief Initializes the portfolio with the default configuration of each size class.
+///        Every class runs the greedy algorithms once to seed the incumbent. Annealing
+///        uses a faster cooling schedule than main.cpp since the time budget cuts it short.
+///
+Portfolio::Portfolio() {
+    for (int c = SMALL; c <= LARGE; ++c) {
+        configs[c].sa = SASolver::Settings(0, 0.99, 50, 1.0, 0.8);
+        configs[c].tabu = TabuSolver::Settings(100000, 2000, 20, true, true);
+        configs[c].lahc = LAHCSolver::Settings(5000);
+        configs[c].memetic = MemeticSolver::Settings(40, 1000, 50, 0.5);
+        configs[c].entries.push_back(Entry(GREEDY, 0));
+    }
+    configs[SMALL].entries.push_back(Entry(SIMULATED_ANNEALING, 2));
+    configs[SMALL].entries.push_back(Entry(LATE_ACCEPTANCE, 1));
+    configs[SMALL].entries.push_back(Entry(MEMETIC, 1));
+    configs[SMALL].entries.push_back(Entry(TABU_SEARCH, 1));
+
+    configs[MEDIUM].entries.push_back(Entry(MEMETIC, 2));
+    configs[MEDIUM].entries.push_back(Entry(SIMULATED_ANNEALING, 2));
+    configs[MEDIUM].entries.push_back(Entry(LATE_ACCEPTANCE, 1));
+    configs[MEDIUM].entries.push_back(Entry(TABU_SEARCH, 1));
+
+    configs[LARGE].entries.push_back(Entry(MEMETIC, 3));
+    configs[LARGE].entries.push_back(Entry(SIMULATED_ANNEALING, 2));
+    configs[LARGE].entries.push_back(Entry(LATE_ACCEPTANCE, 1));
+    configs[LARGE].entries.push_back(Entry(TABU_SEARCH, 1));
+}
+
+///
+/// \brief Replaces the configuration of a size class.
+/// \param sizeClass: Size class to configure.
+/// \param config: New configuration.
+///
+void Portfolio::setConfig(SizeClass sizeClass, const Config &config) {
+    configs[sizeClass] = config;
+}
+
+///
+/// \brief Returns the configuration of a size class.
+/// \param sizeClass: Size class.
+/// \return Constant reference to the configuration.
+///
+const Portfolio::Config &Portfolio::getConfig(SizeClass sizeClass) const {
+    return configs[sizeClass];
+}
+
+///
+/// \brief Solves the Input with the configuration of its size class.
+/// \param input: Problem is specified by this Input.
+/// \param numCores: Number of cores to split among the solvers.
+/// \param timeBudget: Wall-clock time budget in seconds.
+/// \param seed: Seed for pseudo-random number generator.
+/// \return The best task sequence found by any solver, specified by an untrimmed Output.
+///
+Output Portfolio::solve(const Input &input, int numCores, double timeBudget, int seed) const {
+    SolveControl control(timeBudget);
+    return solve(input, numCores, control, seed);
+}
+
+///
+/// \brief Solves the Input with the configuration of its size class, sharing the given
+///        control. Returns once every solver has returned.
+/// \param input: Problem is specified by this Input.
+/// \param numCores: Number of cores to split among the solvers.
+/// \param control: Deadline and incumbent shared by the solvers.
+/// \param seed: Seed for pseudo-random number generator.
+/// \return The best task sequence found by any solver, specified by an untrimmed Output.
+///
+Output Portfolio::solve(const Input &input, int numCores, SolveControl &control, int seed) const {
+    const Config& config = configs[sizeClassOf(input)];
+    std::vector<int> cores = splitCores(config.entries, numCores);
+    std::vector<std::unique_ptr<Solver>> solvers;
+    std::vector<std::thread> threads;
+    for (size_t k = 0; k < config.entries.size(); ++k) {
+        if (cores[k] == 0) {
+            continue;
+        }
+        solvers.push_back(makeSolver(config.entries[k].engine, input, config));
+        Solver* solver = solvers.back().get();
+        int solverSeed = seed + 1000 * static_cast<int>(k);
+        int numThreads = cores[k];
+        threads.emplace_back([solver, solverSeed, numThreads, &control] {
+            solver->run(solverSeed, numThreads, control);
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    Output best;
+    double profit;
+    control.getIncumbent(best, profit);
+    return best;
+}
+
+///
+/// \brief Solves the Input with a single engine, using the settings of its size class.
+/// \param engine: Solver to run.
+/// \param input: Problem is specified by this Input.
+/// \param numCores: Number of threads of the solver.
+/// \param control: Deadline and incumbent of the solver.
+/// \param seed: Seed for pseudo-random number generator.
+/// \return The best task sequence found, specified by an untrimmed Output.
+///
+Output Portfolio::solveWith(Engine engine, const Input &input, int numCores, SolveControl &control, int seed) const {
+    std::unique_ptr<Solver> solver = makeSolver(engine, input, configs[sizeClassOf(input)]);
+    Output out = solver->run(seed, numCores, control);
+    control.offer(out, out.evaluate(input));
+    Output best;
+    double profit;
+    control.getIncumbent(best, profit);
+    return best;
+}
+
+///
+/// \brief Returns the size class of an Input by its number of tasks.
+/// \param input: Problem is specified by this Input.
+/// \return SMALL for up to TASKS_100_MAX tasks, MEDIUM for up to TASKS_150_MAX, LARGE otherwise.
+///
+Portfolio::SizeClass Portfolio::sizeClassOf(const Input &input) {
+    if (input.size() <= TASKS_100_MAX) {
+        return SMALL;
+    } else if (input.size() <= TASKS_150_MAX) {
+        return MEDIUM;
+    } else {
+        return LARGE;
+    }
+}
+
+///
+/// \brief Constructs a solver with the settings of a configuration.
+/// \param engine: Solver to construct.
+/// \param input: Problem is specified by this Input.
+/// \param config: Configuration holding the settings of each engine.
+/// \return The new solver.
+///
+std::unique_ptr<Solver> Portfolio::makeSolver(Engine engine, const Input &input, const Config &config) {
+    switch (engine) {
+    case TABU_SEARCH:
+        return std::unique_ptr<Solver>(new TabuSolver(input, config.tabu));
+    case LATE_ACCEPTANCE:
+        return std::unique_ptr<Solver>(new LAHCSolver(input, config.lahc));
+    case MEMETIC:
+        return std::unique_ptr<Solver>(new MemeticSolver(input, config.memetic));
+    case DYNASEARCH:
+        return std::unique_ptr<Solver>(new DynasearchSolver(input, config.dynasearch));
+    case LARGE_NEIGHBOURHOOD:
+        return std::unique_ptr<Solver>(new LNSSolver(input, config.lns));
+    case VARIABLE_NEIGHBOURHOOD:
+        return std::unique_ptr<Solver>(new VNSSolver(input, config.vns));
+    case GREEDY:
+        return std::unique_ptr<Solver>(new GreedySolver(input));
+    case NAIVE:
+        return std::unique_ptr<Solver>(new NaiveSolver(input));
+    default:
+        return std::unique_ptr<Solver>(new SASolver(input, config.sa));
+    }
+}
+
+///
+/// \brief Splits cores among entries in proportion to their shares. Every entry with a
+///        positive share gets at least one core as long as there are enough cores, in
+///        which case later entries are left out. Entries with zero share get one thread.
+/// \param entries: Entries of a configuration.
+/// \param numCores: Number of cores available.
+/// \return Number of threads of each entry, zero for entries that are left out.
+///
+std::vector<int> Portfolio::splitCores(const std::vector<Entry> &entries, int numCores) {
+    std::vector<int> cores(entries.size(), 0);
+    int totalShare = 0;
+    for (size_t k = 0; k < entries.size(); ++k) {
+        if (entries[k].share > 0) {
+            totalShare += entries[k].share;
+        } else {
+            cores[k] = 1;
+        }
+    }
+    int remaining = numCores;
+    for (size_t k = 0; k < entries.size() && remaining > 0; ++k) {
+        if (entries[k].share > 0) {
+            cores[k] = 1;
+            --remaining;
+        }
+    }
+    // Give each remaining core to the entry furthest below its proportional number of cores.
+    for (; remaining > 0; --remaining) {
+        int neediest = -1;
+        double maxDeficit = -1e300;
+        for (size_t k = 0; k < entries.size(); ++k) {
+            if (entries[k].share > 0) {
+                double deficit = static_cast<double>(numCores) * entries[k].share / totalShare - cores[k];
+                if (deficit > maxDeficit) {
+                    maxDeficit = deficit;
+                    neediest = static_cast<int>(k);
+                }
+            }
+        }
+        if (neediest < 0) {
+            break;
+        }
+        ++cores[neediest];
+    }
+    return cores;
+}
+
+///
+/// \brief Returns whether an entry of the configuration runs an engine.
+/// \param engine: Solver engine.
+/// \return True if the engine is part of the configuration.
+///
+bool Portfolio::Config::uses(Engine engine) const {
+    for (const Entry& e : entries) {
+        if (e.engine == engine) {
+            return true;
+        }
+    }
+    return false;
+}
+
+///
+/// \brief Sends the entries and the settings of a configuration to the output stream.
+///        Settings of the engines added after the original four are only sent if used,
+///        so that descriptions of existing configurations stay the same.
+/// \param out: output stream.
+/// \param c: Configuration to print.
+/// \return R/W reference to the output stream.
+///
+std::ostream& operator <<(std::ostream& out, const Portfolio::Config& c) {
+    out << "Portfolio entries == ";
+    for (const Portfolio::Entry& e : c.entries) {
+        out << engineName(e.engine) << " x" << e.share << ' ';
+    }
+    out << "\n--- " << engineName(SIMULATED_ANNEALING) << " ---\n" << c.sa;
+    out << "--- " << engineName(TABU_SEARCH) << " ---\n" << c.tabu;
+    out << "--- " << engineName(LATE_ACCEPTANCE) << " ---\n" << c.lahc;
+    out << "--- " << engineName(MEMETIC) << " ---\n" << c.memetic;
+    if (c.uses(DYNASEARCH)) {
+        out << "--- " << engineName(DYNASEARCH) << " ---\n" << c.dynasearch;
+    }
+    if (c.uses(LARGE_NEIGHBOURHOOD)) {
+        out << "--- " << engineName(LARGE_NEIGHBOURHOOD) << " ---\n" << c.lns;
+    }
+    if (c.uses(VARIABLE_NEIGHBOURHOOD)) {
+        out << "--- " << engineName(VARIABLE_NEIGHBOURHOOD) << " ---\n" << c.vns;
+    }
+    return out;
+}
@@ -0,0 +1,72 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+#include <memory>
+#include <vector>
+#include "input.h"
+#include "output.h"
+#include "solver.h"
+#include "sasolver.h"
+#include "tabusolver.h"
+#include "lahcsolver.h"
+#include "memeticsolver.h"
+#include "dynasearchsolver.h"
+#include "lnssolver.h"
+#include "vnssolver.h"
+
+///
+/// \brief Runs several solvers concurrently on the same Input under a wall-clock
+///        time budget. All solvers share one SolveControl, so every solver sees the
+///        best Output found so far and may restart from it. Which solvers run, how
+///        the cores are split among them, and their settings depend on the size
+///        class of the Input.
+///
+class Portfolio
+{
+public:
+    enum SizeClass { SMALL, MEDIUM, LARGE };
+
+    struct Entry {
+        Engine engine;  // Solver to run.
+        int share;      // Relative number of cores given to the solver. Zero runs it on one extra thread,
+                        // which is meant for solvers that finish almost immediately such as GREEDY.
+
+        Entry(Engine engine = SIMULATED_ANNEALING, int share = 1) {
+            this->engine = engine;
+            this->share = share;
+        }
+    };
+
+    struct Config {
+        std::vector<Entry> entries;
+        SASolver::Settings sa;
+        TabuSolver::Settings tabu;
+        LAHCSolver::Settings lahc;
+        MemeticSolver::Settings memetic;
+        DynasearchSolver::Settings dynasearch;
+        LNSSolver::Settings lns;
+        VNSSolver::Settings vns;
+
+        bool uses(Engine engine) const;
+
+        friend std::ostream& operator <<(std::ostream& out, const Config& c);
+    };
+
+private:
+    Config configs[3];
+
+public:
+    Portfolio();
+
+    void setConfig(SizeClass sizeClass, const Config& config);
+    const Config& getConfig(SizeClass sizeClass) const;
+
+    Output solve(const Input& input, int numCores, double timeBudget, int seed = 0) const;
+    Output solve(const Input& input, int numCores, SolveControl& control, int seed = 0) const;
+    Output solveWith(Engine engine, const Input& input, int numCores, SolveControl& control, int seed = 0) const;
+
+    static SizeClass sizeClassOf(const Input& input);
+    static std::unique_ptr<Solver> makeSolver(Engine engine, const Input& input, const Config& config);
+    static std::vector<int> splitCores(const std::vector<Entry>& entries, int numCores);
+};
+
+#endif // PORTFOLIO_H
@@ -0,0 +1,103 @@
+#include "presets.h"
+#include <fstream>
+#include <sstream>
+
+///
+/// \brief Initializes every size class with the same settings.
+/// \param fallback: Settings used until a preset file overrides them.
+///
+SettingsPresets::SettingsPresets(const SASolver::Settings &fallback) {
+    for (int c = Portfolio::SMALL; c <= Portfolio::LARGE; ++c) {
+        presets[c] = fallback;
+    }
+}
+
+///
+/// \brief Reads presets from a file. Only alpha, maxRejections, epochSizeFactor, and
+///        initAccRate are read, the other settings keep their current values.
+/// \param fileName: Directory to the preset file.
+/// \return False if the file cannot be opened or a line is malformed, in which case
+///         the lines before it are still applied.
+///
+bool SettingsPresets::readFile(const std::string &fileName) {
+    std::fstream fs(fileName, std::fstream::in);
+    if (!fs.good()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(fs, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::stringstream ss(line);
+        std::string name;
+        SASolver::Settings s;
+        if (!(ss >> name >> s.alpha >> s.maxRejections >> s.epochSizeFactor >> s.initAccRate)) {
+            return false;
+        }
+        int c = Portfolio::SMALL;
+        while (c <= Portfolio::LARGE && name != className(static_cast<Portfolio::SizeClass>(c))) {
+            ++c;
+        }
+        if (c > Portfolio::LARGE) {
+            return false;
+        }
+        presets[c].alpha = s.alpha;
+        presets[c].maxRejections = s.maxRejections;
+        presets[c].epochSizeFactor = s.epochSizeFactor;
+        presets[c].initAccRate = s.initAccRate;
+    }
+    return true;
+}
+
+///
+/// \brief Writes the presets of all size classes to a file.
+/// \param fileName: Directory to the preset file. Overwrites if file already exists.
+///
+void SettingsPresets::writeFile(const std::string &fileName) const {
+    std::fstream fs(fileName, std::fstream::out);
+    fs << "# class alpha maxRejections epochSizeFactor initAccRate\n";
+    for (int c = Portfolio::SMALL; c <= Portfolio::LARGE; ++c) {
+        const SASolver::Settings& s = presets[c];
+        fs << className(static_cast<Portfolio::SizeClass>(c)) << ' ' << s.alpha << ' ' << s.maxRejections << ' '
+           << s.epochSizeFactor << ' ' << s.initAccRate << '\n';
+    }
+    fs.close();
+}
+
+///
+/// \brief Replaces the settings of a size class.
+/// \param sizeClass: Size class.
+/// \param s: New settings.
+///
+void SettingsPresets::set(Portfolio::SizeClass sizeClass, const SASolver::Settings &s) {
+    presets[sizeClass] = s;
+}
+
+///
+/// \brief Returns the settings of a size class.
+/// \param sizeClass: Size class.
+/// \return Constant reference to the settings.
+///
+const SASolver::Settings &SettingsPresets::get(Portfolio::SizeClass sizeClass) const {
+    return presets[sizeClass];
+}
+
+///
+/// \brief Returns the settings for the size class of an Input.
+/// \param input: Problem is specified by this Input.
+/// \return Constant reference to the settings.
+///
+const SASolver::Settings &SettingsPresets::forInput(const Input &input) const {
+    return presets[Portfolio::sizeClassOf(input)];
+}
+
+///
+/// \brief Returns the name of a size class as used in preset files and the inputs folder.
+/// \param sizeClass: Size class.
+/// \return "small", "medium", or "large".
+///
+const char *SettingsPresets::className(Portfolio::SizeClass sizeClass) {
+    static const char* const NAMES[] = {"small", "medium", "large"};
+    return NAMES[sizeClass];
+}
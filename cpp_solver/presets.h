@@ -0,0 +1,33 @@
+#ifndef PRESETS_H
+#define PRESETS_H
+#include <string>
+#include "input.h"
+#include "portfolio.h"
+#include "sasolver.h"
+
+///
+/// \brief SASolver::Settings for each size class, as written by the tuner in
+///        benchmark/tuner.cpp. Each line of a preset file is
+///        "<small|medium|large> alpha maxRejections epochSizeFactor initAccRate",
+///        lines starting with '#' are comments. Size classes missing from the file
+///        keep the fallback settings.
+///
+class SettingsPresets
+{
+private:
+    SASolver::Settings presets[3];
+
+public:
+    SettingsPresets(const SASolver::Settings& fallback = SASolver::Settings());
+
+    bool readFile(const std::string& fileName);
+    void writeFile(const std::string& fileName) const;
+
+    void set(Portfolio::SizeClass sizeClass, const SASolver::Settings& s);
+    const SASolver::Settings& get(Portfolio::SizeClass sizeClass) const;
+    const SASolver::Settings& forInput(const Input& input) const;
+
+    static const char* className(Portfolio::SizeClass sizeClass);
+};
+
+#endif // PRESETS_H
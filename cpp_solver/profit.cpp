@@ -0,0 +1,75 @@
+#include "profit.h"
+#include <cmath>
+#include <vector>
+
+///
+/// \brief Returns the profit earned by a task that finishes within the global deadline.
+/// \param input: Problem is specified by this Input.
+/// \param task: 0-indexed task.
+/// \param minutesLate: Number of minutes the task finishes after its deadline, may be negative.
+/// \return Profit earned by the task.
+///
+FloatingProfit::Value FloatingProfit::gain(const Input &input, int task, int minutesLate) {
+    return input.getProfit(task) * latePenalty(minutesLate > 0 ? minutesLate : 0);
+}
+
+///
+/// \brief Returns exp(-LATE_DECAY_RATE * minutesLate) using a precomputed table.
+///        The table holds exactly the values Output::evaluate computes, so both
+///        evaluations agree task by task. Tasks later than MAX_TIME, which only happens
+///        for Inputs with a longer horizon, compute the same value directly.
+/// \param minutesLate: Number of minutes the task finishes after its deadline (non-negative).
+/// \return Factor applied to the profit of the task.
+///
+double FloatingProfit::latePenalty(int minutesLate) {
+    if (minutesLate > MAX_TIME) {
+        return exp(-LATE_DECAY_RATE * minutesLate);
+    }
+    return latePenaltyTable()[minutesLate];
+}
+
+///
+/// \brief Returns the table used by latePenalty for up to MAX_TIME minutes late.
+/// \return table[m] == exp(-LATE_DECAY_RATE * m) for m > 0, and 1.0 for m == 0.
+///
+const std::vector<double> &FloatingProfit::latePenaltyTable() {
+    static const std::vector<double> table = [] {
+        std::vector<double> t(MAX_TIME + 1);
+        for (int m = 0; m <= MAX_TIME; ++m) {
+            t[m] = m > 0 ? exp(-LATE_DECAY_RATE * m) : 1.0;
+        }
+        return t;
+    }();
+    return table;
+}
+
+///
+/// \brief Returns the profit earned by a task that finishes within the global deadline.
+/// \param input: Problem is specified by this Input.
+/// \param task: 0-indexed task.
+/// \param minutesLate: Number of minutes the task finishes after its deadline, may be negative.
+/// \return Profit earned by the task in units of 1 / UNIT.
+///
+FixedProfit::Value FixedProfit::gain(const Input &input, int task, int minutesLate) {
+    return input.getScaledProfit(task) * latePenalty(minutesLate > 0 ? minutesLate : 0);
+}
+
+///
+/// \brief Returns exp(-LATE_DECAY_RATE * minutesLate) rounded to FRACTION_BITS fractional bits.
+///        The factor rounds to zero long before MAX_TIME minutes late.
+/// \param minutesLate: Number of minutes the task finishes after its deadline (non-negative).
+/// \return Factor applied to the scaled profit of the task, 1 << FRACTION_BITS if on time.
+///
+FixedProfit::Value FixedProfit::latePenalty(int minutesLate) {
+    if (minutesLate > MAX_TIME) {
+        return 0;
+    }
+    static const std::vector<Value> table = [] {
+        std::vector<Value> t(MAX_TIME + 1);
+        for (int m = 0; m <= MAX_TIME; ++m) {
+            t[m] = m > 0 ? llround(ldexp(exp(-LATE_DECAY_RATE * m), FRACTION_BITS)) : 1LL << FRACTION_BITS;
+        }
+        return t;
+    }();
+    return table[minutesLate];
+}
@@ -0,0 +1,49 @@
+#ifndef PROFIT_H
+#define PROFIT_H
+#include "input.h"
+#include <vector>
+
+///
+/// \brief Profit arithmetic in double precision. Every task earns exactly what
+///        Output::evaluate computes for it.
+///
+struct FloatingProfit {
+    typedef double Value;
+
+    static Value gain(const Input& input, int task, int minutesLate);
+    static double latePenalty(int minutesLate);
+    static const std::vector<double>& latePenaltyTable();
+
+    static double toDouble(Value v) {
+        return v;
+    }
+    static Value fromDouble(double d) {
+        return d;
+    }
+};
+
+///
+/// \brief Profit arithmetic in 64-bit integers. A profit of 1.0 is represented by UNIT.
+///        On-time profits are exact since profits have at most three decimals, and late
+///        penalty factors are fixed-point numbers with FRACTION_BITS fractional bits, so
+///        the profit of a task is off by less than 1e-5 compared to Output::evaluate.
+///        Sums are exact, so incremental totals never drift from a full evaluation,
+///        and comparisons against thresholds are exact.
+///
+struct FixedProfit {
+    typedef long long Value;
+    static const int FRACTION_BITS = 24;
+    static const Value UNIT = static_cast<Value>(PROFIT_SCALE) << FRACTION_BITS;
+
+    static Value gain(const Input& input, int task, int minutesLate);
+    static Value latePenalty(int minutesLate);
+
+    static double toDouble(Value v) {
+        return static_cast<double>(v) / UNIT;
+    }
+    static Value fromDouble(double d) {
+        return static_cast<Value>(d * UNIT + (d < 0 ? -0.5 : 0.5));
+    }
+};
+
+#endif // PROFIT_H
@@ -0,0 +1,138 @@
+#include "resultcache.h"
+#include "hash.h"
+#include "packedcorpus.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+///
+/// \brief Loads the records of a cache file, which is created on the first store if missing.
+/// \param fileName: Directory to the cache file.
+///
+ResultCache::ResultCache(const std::string &fileName) : fileName(fileName) {
+    std::ifstream fs(fileName);
+    std::string line;
+    while (std::getline(fs, line)) {
+        std::istringstream ss(line);
+        uint64_t key;
+        Record record;
+        size_t length;
+        if (!(ss >> std::hex >> key >> std::dec >> record.profit >> record.cpuSeconds >> length)) {
+            continue;   // skip a line cut short by an interrupted run
+        }
+        std::vector<int> schedule(length);
+        for (size_t k = 0; k < length && ss >> schedule[k]; ++k) {}
+        if (!ss) {
+            continue;
+        }
+        record.output = Output(schedule);
+        insert(key, record);
+    }
+}
+
+///
+/// \brief Returns the number of keys in the cache.
+/// \return Number of keys.
+///
+size_t ResultCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return records.size();
+}
+
+///
+/// \brief Looks up the best record of a key.
+/// \param key: Key returned by ResultCache::key.
+/// \param record: Assigned the record if found.
+/// \return False if the key has never been stored.
+///
+bool ResultCache::lookup(uint64_t key, Record &record) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<uint64_t, Record>::const_iterator it = records.find(key);
+    if (it == records.end()) {
+        return false;
+    }
+    record = it->second;
+    return true;
+}
+
+///
+/// \brief Stores the result of a run if the key is new or the profit improves on the
+///        stored record, and appends it to the cache file.
+/// \param key: Key returned by ResultCache::key.
+/// \param output: Best Output of the run.
+/// \param profit: Profit of the Output.
+/// \param cpuSeconds: CPU time of the run.
+/// \return True if the record was stored.
+///
+bool ResultCache::store(uint64_t key, const Output &output, double profit, double cpuSeconds) {
+    Record record;
+    record.output = output;
+    record.profit = profit;
+    record.cpuSeconds = cpuSeconds;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!insert(key, record)) {
+        return false;
+    }
+    std::ofstream fs(fileName, std::ofstream::app);
+    fs << std::hex << std::setw(16) << std::setfill('0') << key << std::dec << std::setfill(' ')
+       << ' ' << std::setprecision(17) << profit << ' ' << cpuSeconds << ' ' << output.size();
+    for (int task : output.getSchedule()) {
+        fs << ' ' << task;
+    }
+    fs << '\n';
+    return true;
+}
+
+///
+/// \brief Stores every record of another cache that is new or improves on this cache,
+///        such as the cache of another process solving the same configurations.
+/// \param other: Cache to merge, with a different file.
+/// \return Number of records stored.
+///
+size_t ResultCache::mergeFrom(const ResultCache &other) {
+    std::unordered_map<uint64_t, Record> theirs;
+    {
+        std::lock_guard<std::mutex> lock(other.mutex);
+        theirs = other.records;
+    }
+    size_t stored = 0;
+    for (const std::pair<const uint64_t, Record>& entry : theirs) {
+        stored += store(entry.first, entry.second.output, entry.second.profit, entry.second.cpuSeconds);
+    }
+    return stored;
+}
+
+///
+/// \brief Returns the key of an Input solved with a configuration.
+/// \param input: Problem is specified by this Input.
+/// \param config: Description of everything that affects the result, such as the
+///        engine and the printed settings.
+/// \return Hash of the contents of the Input and the configuration.
+///
+uint64_t ResultCache::key(const Input &input, const std::string &config) {
+    return key(PackedCorpus::hashTasks(input), config);
+}
+
+///
+/// \brief Returns the key of an instance of a packed corpus solved with a configuration,
+///        without building its Input.
+/// \param inputHash: PackedCorpus::inputHash of the instance.
+/// \param config: Description of the configuration.
+/// \return Same key as ResultCache::key of the Input of the instance.
+///
+uint64_t ResultCache::key(uint64_t inputHash, const std::string &config) {
+    return hashBytes(config.data(), config.size(), inputHash);
+}
+
+///
+/// \brief Keeps the record if it is the first or the most profitable of its key.
+///        The caller must hold the mutex, except in the constructor.
+///
+bool ResultCache::insert(uint64_t key, const Record &record) {
+    std::unordered_map<uint64_t, Record>::iterator it = records.find(key);
+    if (it != records.end() && record.profit <= it->second.profit) {
+        return false;
+    }
+    records[key] = record;
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "input.h"
+#include "output.h"
+
+///
+/// \brief Persistent store of the best Output found for each pair of Input contents and
+///        solver configuration. Keys are content hashes, so renamed or duplicated inputs
+///        hit the same entry and edited inputs miss it. All records are kept in memory;
+///        the file is an append-only log with one record per line,
+///        "<key in hex> <profit> <cpuSeconds> <length> <0-indexed tasks...>",
+///        of which the most profitable record of each key wins when loading.
+///
+class ResultCache
+{
+public:
+    struct Record {
+        Output output;          // Untrimmed, so that solvers can restart from it, unless seeded from an output file.
+        double profit = 0.0;
+        double cpuSeconds = 0.0;    // CPU time of the run that found the Output.
+    };
+
+private:
+    std::string fileName;
+    std::unordered_map<uint64_t, Record> records;
+    mutable std::mutex mutex;
+
+public:
+    ResultCache(const std::string& fileName);
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator =(const ResultCache&) = delete;
+
+    size_t size() const;
+    bool lookup(uint64_t key, Record& record) const;
+    bool store(uint64_t key, const Output& output, double profit, double cpuSeconds);
+    size_t mergeFrom(const ResultCache& other);
+
+    static uint64_t key(const Input& input, const std::string& config);
+    static uint64_t key(uint64_t inputHash, const std::string& config);
+
+private:
+    bool insert(uint64_t key, const Record& record);
+};
+
+#endif // RESULTCACHE_H
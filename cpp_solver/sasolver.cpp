@@ -1,5 +1,11 @@
 #include "sasolver.h"
+#include "batcheval.h"
+#include "compactschedule.h"
+#include "dynasearch.h"
+#include "greedysolver.h"
 #include <algorithm>
+#include <chrono>
+#include <memory>
 #include <thread>
 
 SASolver::SASolver() {}
@@ -7,9 +13,11 @@ SASolver::SASolver() {}
 ///
 /// \brief Initializes a solver instance using the Input.
 /// \param in: Problem is specified by this Input.
+/// \param s: Settings used by run().
 ///
-SASolver::SASolver(const Input& in) {
+SASolver::SASolver(const Input& in, const Settings& s) {
     input = in;
+    settings = s;
     uniformTaskNumDist = std::uniform_int_distribution<int>(0, in.size() - 1);
     uniformRealDist = std::uniform_real_distribution<double>(0.0, 1.0);
 }
@@ -22,24 +30,111 @@ SASolver::SASolver(const Input& in) {
 ///         specified by an untrimmed Output.
 ///
 Output SASolver::solve(int seed, Settings s) {
+    return solveFrom(Output(), seed, s);
+}
+
+///
+/// \brief Solves the problem like solve(), but every thread anneals from the same initial
+///        sequence instead of a random one. With a low initAccRate, the result stays close
+///        to the initial sequence and is never worse than it.
+/// \param initial: Initial task sequence, random if empty (greedy in large-instance mode).
+///        Missing tasks are appended.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param s: settings for the solver.
+/// \return The best task sequence found by the algorithm
+///         specified by an untrimmed Output.
+///
+Output SASolver::solveFrom(const Output &initial, int seed, Settings s) {
     if (s.verbose) {
         std::cout << "seed == " << seed << '\n';
+        std::cout << "Printing Parameters... \n" << s;
+        std::cout << "Input size == " << input.size() << '\n';
+        std::cout << "Profit gain threshold == " << PROFIT_GAIN_THRESH << '\n';
+    }
+    Output start;
+    if (initial.size() > 0) {
+        start = ScheduleState(input, initial).toOutput();
+    } else if (s.moveWindow > 0) {
+        start = greedyStart();
+    }
+    std::unique_ptr<TraceWriter> tracer;
+    if (s.verbose || !s.traceFile.empty()) {
+        tracer.reset(new TraceWriter(s.traceFile, NUM_THREADS));
     }
     std::vector<std::mt19937_64> gens(NUM_THREADS);
     std::vector<std::thread> threads;
     std::vector<Output> bestSequences(NUM_THREADS);
+    threadMetrics.assign(NUM_THREADS, SolverMetrics());
+    ThreadPlacement placement(s.placement);
     for (int tid = 0; tid < NUM_THREADS; ++tid) {
         gens[tid].seed(seed + tid);
         threads.emplace_back(std::thread(&SASolver::solveThread,
-                                         *this,
+                                         this,
                                          std::ref(bestSequences[tid]),
                                          std::ref(gens[tid]),
-                                         s));
+                                         s,
+                                         std::ref(threadMetrics[tid]),
+                                         tracer ? tracer->buffer(tid) : nullptr,
+                                         start.size() > 0 ? &start : nullptr,
+                                         placement.cpuFor(tid)));
     }
     for (int tid = 0; tid < NUM_THREADS; ++tid) {
         threads[tid].join();
     }
-    return bestSequence(bestSequences);
+    if (tracer) {
+        tracer->close();
+    }
+    return bestSequence(input, bestSequences);
+}
+
+///
+/// \brief Returns the counters collected by each thread during the last call to solve().
+/// \return Metrics of each thread.
+///
+const std::vector<SolverMetrics> &SASolver::getMetrics() const {
+    return threadMetrics;
+}
+
+///
+/// \brief Returns the name of the solver.
+/// \return Name of the solver.
+///
+std::string SASolver::name() const {
+    return "SA";
+}
+
+///
+/// \brief Anneals on numThreads threads with the settings given at construction,
+///        restarting until the control asks to stop. In large-instance mode, every
+///        thread starts from the best greedy sequence instead of a random one.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param numThreads: Number of threads to anneal on.
+/// \param control: Deadline and incumbent shared with other solvers.
+/// \return The best task sequence found by this solver.
+///
+Output SASolver::run(int seed, int numThreads, SolveControl &control) {
+    Output start;
+    if (settings.moveWindow > 0) {
+        start = greedyStart();
+    }
+    std::vector<std::mt19937_64> gens(numThreads);
+    std::vector<std::thread> threads;
+    std::vector<Output> bestSequences(numThreads);
+    ThreadPlacement placement(settings.placement);
+    for (int tid = 0; tid < numThreads; ++tid) {
+        gens[tid].seed(seed + tid);
+        threads.emplace_back(std::thread(&SASolver::runThread,
+                                         this,
+                                         std::ref(bestSequences[tid]),
+                                         std::ref(gens[tid]),
+                                         std::ref(control),
+                                         start.size() > 0 ? &start : nullptr,
+                                         placement.cpuFor(tid)));
+    }
+    for (int tid = 0; tid < numThreads; ++tid) {
+        threads[tid].join();
+    }
+    return bestSequence(input, bestSequences);
 }
 
 ///
@@ -47,91 +142,290 @@ Output SASolver::solve(int seed, Settings s) {
 /// \param bestSequence: Assigned to be the result upon completion.
 /// \param gen: Random generator.
 /// \param s: Settings for the solver.
+/// \param metrics: Counters of this thread.
+/// \param traceBuffer: Buffer to push the trace events of this thread to, nullptr if not tracing.
+/// \param initial: Complete sequence to anneal from, nullptr to start from a random sequence.
+/// \param cpu: CPU to pin the thread to before it copies the Input and allocates its buffers,
+///        -1 to leave it unpinned.
 ///
-void SASolver::solveThread(Output &bestSequence, std::mt19937_64& gen, const Settings& s) {
-    Output currSequence = generateRandomSequence(gen);
+void SASolver::solveThread(Output &bestSequence, std::mt19937_64& sharedGen, const Settings& s, SolverMetrics& metrics,
+                           TraceBuffer* traceBuffer, const Output* initial, int cpu) const {
+    if (ThreadPlacement::pinCurrentThread(cpu)) {
+        metrics.cpu = cpu;
+    }
+    SASolver worker(input, settings);   // copied by this thread once pinned, so the Input is on its node
+    worker.trace = traceBuffer;
+    std::mt19937_64 gen = sharedGen;    // allocated by this thread, apart from the generators of other threads
+    Output currSequence = initial ? *initial : randomSequence(worker.input, gen);
     bestSequence = currSequence;
-    double maxProfit = currSequence.evaluate(input);
+    double maxProfit = currSequence.evaluate(worker.input);
     for (int restart = -1; restart < s.maxRestarts; ++restart) {
-        solveInstance(currSequence, gen, s);
-        double currProfit = currSequence.evaluate(input);
+        worker.solveInstance(currSequence, gen, s, metrics);
+        double currProfit = currSequence.evaluate(worker.input);
+        if (currProfit > maxProfit) {
+            maxProfit = currProfit;
+            bestSequence = currSequence;
+        }
+    }
+}
+
+///
+/// \brief Keeps annealing until the control asks to stop. A restart begins from the
+///        shared incumbent if another thread or solver found a better sequence than
+///        this thread, and from the initial or a random sequence otherwise.
+/// \param bestSequence: Assigned to be the best sequence found by this thread.
+/// \param gen: Random generator.
+/// \param control: Deadline and incumbent shared with other solvers.
+/// \param initial: Complete sequence to start and restart from instead of a random one, may be nullptr.
+/// \param cpu: CPU to pin the thread to before it copies the Input and allocates its buffers,
+///        -1 to leave it unpinned.
+///
+void SASolver::runThread(Output &bestSequence, std::mt19937_64 &sharedGen, SolveControl &control, const Output* initial,
+                         int cpu) const {
+    ThreadPlacement::pinCurrentThread(cpu);
+    SASolver worker(input, settings);   // copied by this thread once pinned, so the Input is on its node
+    std::mt19937_64 gen = sharedGen;    // allocated by this thread, apart from the generators of other threads
+    Output currSequence = initial ? *initial : randomSequence(worker.input, gen);
+    bestSequence = currSequence;
+    double maxProfit = currSequence.evaluate(worker.input);
+    SolverMetrics metrics;
+    while (!control.shouldStop()) {
+        worker.solveInstance(currSequence, gen, settings, metrics, &control);
+        double currProfit = currSequence.evaluate(worker.input);
         if (currProfit > maxProfit) {
             maxProfit = currProfit;
             bestSequence = currSequence;
         }
+        control.offer(currSequence, currProfit);
+        if (control.getIncumbentProfit() <= maxProfit || !control.getIncumbent(currSequence, currProfit)) {
+            currSequence = initial ? *initial : randomSequence(worker.input, gen);
+        }
     }
 }
 
 ///
-/// \brief Solves an instance without restarting.
+/// \brief Solves an instance without restarting. Valid Inputs of up to 100, 150, or 200
+///        tasks with the standard horizon anneal a CompactSchedule specialized for that
+///        capacity and horizon, and other Inputs the generic one; both evaluate exactly like
+///        Output::evaluate. If s.dynasearchPeriod is positive, the current sequence descends
+///        to a local optimum of Dynasearch every dynasearchPeriod epochs and once the system
+///        is frozen.
 /// \param sequence: Assigned to be the result upon completion.
 /// \param gen: Random generator.
 /// \param s: Settings for the solver.
+/// \param metrics: Counters of the calling thread.
+/// \param control: If specified, cooling stops early when the control asks to stop,
+///        and improvements are offered to it after every epoch.
 ///
-void SASolver::solveInstance(Output& sequence, std::mt19937_64& gen, Settings s) {
-    if (s.verbose) {
-        std::cout << "---------------- SIMULATED ANNEALING SOLVE BEGIN ----------------\n";
+void SASolver::solveInstance(Output& sequence, std::mt19937_64& gen, Settings s, SolverMetrics& metrics,
+                             SolveControl* control) {
+    if (s.fixedPoint || s.moveWindow > 0) {
+        solveInstanceFixed(sequence, gen, s, metrics, control);
+    } else if (PresetPolicy<100>::accepts(input)) {
+        anneal<PresetPolicy<100>>(sequence, gen, s, metrics, control);
+    } else if (PresetPolicy<150>::accepts(input)) {
+        anneal<PresetPolicy<150>>(sequence, gen, s, metrics, control);
+    } else if (PresetPolicy<200>::accepts(input)) {
+        anneal<PresetPolicy<200>>(sequence, gen, s, metrics, control);
+    } else {
+        anneal<GenericPolicy<>>(sequence, gen, s, metrics, control);
     }
+}
+
+///
+/// \brief Anneals a CompactSchedule of the given problem policy, see solveInstance.
+///
+template <class Policy>
+void SASolver::anneal(Output& sequence, std::mt19937_64& gen, const Settings& s, SolverMetrics& metrics,
+                      SolveControl* control) {
     int n = input.size();               // Number of tasks
     int L = s.epochSizeFactor * n * n;  // Size of (number of perturbations in) each epoch
 
     double currProfit = sequence.evaluate(input);
     double temperature = getInitTemperature(sequence, gen, s.initAccRate);
+    metrics.fullEvaluations += static_cast<long long>(INIT_TEMP_SAMPLE_SIZE_FACTOR * n * n) + 2;
+    CompactSchedule<Policy> schedule(input, sequence);
     int index1, index2;
     int epoch = 0;
     double lastEpochProfit = currProfit;
     int rejectionCount = 0;
+    Dynasearch dynasearch(input, s.moveWindow);
+    auto intensify = [&] {
+        FixedScheduleState state(input, schedule.toOutput());
+        if (dynasearch.descend(state) > 0) {
+            schedule.assign(state.toOutput());
+            currProfit = schedule.evaluate();
+            metrics.fullEvaluations += 1;
+        }
+    };
 
-    if (s.verbose) {
-        std::cout << "\nSequence ramdomly initialized to...\n";
-        std::cout << sequence << '\n';
-        std::cout << "Printing Parameters... \n";
-        std::cout << s;
-        std::cout << "Input size == " << input.size() << '\n';
-        std::cout << "Profit gain threshold == " << PROFIT_GAIN_THRESH << '\n';
-        std::cout << "with current profit == " << currProfit << '\n';
-        std::cout << "Initial temperature == " << temperature << '\n';
-        std::cout << "Epoch size == " << L << '\n';
-        std::cout << "BEGIN COOLING...\n";
+    if (trace) {
+        TraceEvent e = {TraceEvent::BEGIN, 0, metrics.elapsedSeconds(), temperature, currProfit, 0.0, 0};
+        trace->push(e);
     }
 
     // While the system is not frozen
-    while (rejectionCount < s.maxRejections) {
+    while (rejectionCount < s.maxRejections && !(control && control->shouldStop())) {
+        std::chrono::steady_clock::time_point epochStart = std::chrono::steady_clock::now();
+        int accepted = 0;
         for (int i = 0; i < L; ++i) {
-            double newProfit = perturb(sequence, index1, index2, gen);  // Perturb the system to get a random neiboring state
+            // Perturb the system to get a random neiboring state, as perturb() does
+            index1 = uniformTaskNumDist(gen);
+            index2 = uniformTaskNumDist(gen);
+            while (index2 == index1) {
+                index2 = uniformTaskNumDist(gen);
+            }
+            schedule.swapTasks(index1, index2);
+            double newProfit = schedule.evaluate();
             double acceptanceProb = accProb(-currProfit, -newProfit, temperature);
             if (acceptanceProb < uniformRealDist(gen)) {
-                sequence.swapTasks(index1, index2);
+                schedule.swapTasks(index1, index2);
             } else {
+                metrics.recordAccepted(newProfit - currProfit);
                 currProfit = newProfit;
+                ++accepted;
             }
         }
-        if (s.verbose && epoch % s.epochPrintPeriod == 0) {
-            std::cout << "\nEpoch " << epoch << " done.\n";
-            std::cout << "Current profit == " << currProfit << '\n';
-            std::cout << "Profit from last epoch == " << lastEpochProfit << '\n';
+        if (s.dynasearchPeriod > 0 && (epoch + 1) % s.dynasearchPeriod == 0) {
+            intensify();
         }
-        temperature *= s.alpha; // Decrease temperature after each epoch
+        metrics.movesTried += L;
+        metrics.fullEvaluations += L;
+        metrics.epochSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - epochStart).count());
+        metrics.recordBest(currProfit);
         if (currProfit - lastEpochProfit < PROFIT_GAIN_THRESH) {    // Increment rejection count if this epoch is rejected
             ++rejectionCount;
-            if (s.verbose && epoch % s.epochPrintPeriod == 0) {
-                std::cout << "Profit gain smaller than profitGainThresh, epoch rejected.\n";
-                std::cout << "Current rejection count == " << rejectionCount << '\n';
-            }
         } else {                                                    // Reset rejection count otherwise
             rejectionCount = 0;
-            if (s.verbose && epoch % s.epochPrintPeriod == 0) {
-                std::cout << "Profit gain detected, epoch accepted. Rejection count reset to 0.\n";
-            }
+        }
+        if (trace && epoch % s.epochPrintPeriod == 0) {
+            TraceEvent e = {TraceEvent::EPOCH, epoch, metrics.elapsedSeconds(), temperature, currProfit,
+                            static_cast<double>(accepted) / L, rejectionCount};
+            trace->push(e);
+        }
+        temperature *= s.alpha; // Decrease temperature after each epoch
+        if (control && currProfit > control->getIncumbentProfit()) {
+            control->offer(schedule.toOutput(), currProfit);
         }
         lastEpochProfit = currProfit;
         ++epoch;
     }
-    if (s.verbose) {
-        std::cout << "SYSTEM FROZEN, COOLING PROCESS DONE.\n";
-        std::cout << "Printing current task sequence...\n" << sequence << '\n';
-        std::cout << "Final profit == " << currProfit << '\n';
-        std::cout << "---------------- SIMULATED ANNEALING SOLVE DONE ----------------\n";
+    if (s.dynasearchPeriod > 0) {
+        intensify();
+    }
+    metrics.epochsToFreeze.push_back(epoch);
+    sequence = schedule.toOutput();
+    if (trace) {
+        TraceEvent e = {TraceEvent::FROZEN, epoch, metrics.elapsedSeconds(), temperature, currProfit, 0.0, rejectionCount};
+        trace->push(e);
+    }
+}
+
+///
+/// \brief Solves an instance without restarting, like solveInstance, but evaluates each
+///        perturbation incrementally with a FixedScheduleState. Profits are integers, so
+///        the running profit never drifts from a full evaluation and epochs are compared
+///        against PROFIT_GAIN_THRESH exactly. The random numbers drawn are the same as
+///        in solveInstance.
+///        In large-instance mode (s.moveWindow > 0), swaps are drawn between a position
+///        that finishes before the horizon, or up to moveWindow positions after it, and a
+///        position at most moveWindow away. Each swap then costs O(moveWindow) and each
+///        epoch has epochSizeFactor * active * 2 * moveWindow perturbations, where active
+///        is the number of such positions, in place of n * n.
+/// \param sequence: Assigned to be the result upon completion.
+/// \param gen: Random generator.
+/// \param s: Settings for the solver.
+/// \param metrics: Counters of the calling thread.
+/// \param control: If specified, cooling stops early when the control asks to stop,
+///        and improvements are offered to it after every epoch.
+///
+void SASolver::solveInstanceFixed(Output &sequence, std::mt19937_64 &gen, Settings s, SolverMetrics& metrics,
+                                  SolveControl *control) {
+    int n = input.size();               // Number of tasks
+    int window = std::min(s.moveWindow, n - 1);
+    long long L = static_cast<long long>(s.epochSizeFactor * n * n);    // Size of (number of perturbations in) each epoch
+    const FixedScheduleState::Value gainThresh = FixedProfit::fromDouble(PROFIT_GAIN_THRESH);
+
+    double temperature;
+    FixedScheduleState state;
+    if (window > 0) {
+        state = FixedScheduleState(input, sequence);
+        temperature = getInitTemperatureWindowed(state, gen, s);
+    } else {
+        temperature = getInitTemperature(sequence, gen, s.initAccRate);
+        metrics.fullEvaluations += static_cast<long long>(INIT_TEMP_SAMPLE_SIZE_FACTOR * n * n) + 1;
+        state = FixedScheduleState(input, sequence);
+    }
+    FixedScheduleState::Value lastEpochProfit = state.getValue();
+    int epoch = 0;
+    int rejectionCount = 0;
+    Dynasearch dynasearch(input, window);
+
+    if (trace) {
+        TraceEvent e = {TraceEvent::BEGIN, 0, metrics.elapsedSeconds(), temperature, state.getProfit(), 0.0, 0};
+        trace->push(e);
+    }
+
+    // While the system is not frozen
+    while (rejectionCount < s.maxRejections && !(control && control->shouldStop())) {
+        std::chrono::steady_clock::time_point epochStart = std::chrono::steady_clock::now();
+        int active = std::min(n, state.cutoff() + window);
+        if (window > 0) {
+            L = std::max(1LL, static_cast<long long>(s.epochSizeFactor * active * 2 * window));
+        }
+        long long accepted = 0;
+        for (long long i = 0; i < L; ++i) {
+            int index1, index2;
+            if (window > 0) {
+                drawWindowedPair(active, window, index1, index2, gen);
+            } else {
+                index1 = uniformTaskNumDist(gen);
+                index2 = uniformTaskNumDist(gen);
+                while (index2 == index1) {
+                    index2 = uniformTaskNumDist(gen);
+                }
+            }
+            FixedScheduleState::Value delta = state.swapDelta(index1, index2);
+            double acceptanceProb = accProb(0.0, -FixedProfit::toDouble(delta), temperature);
+            if (acceptanceProb >= uniformRealDist(gen)) {
+                state.applySwap(index1, index2);
+                metrics.recordAccepted(static_cast<double>(delta));
+                ++accepted;
+            }
+        }
+        if (s.dynasearchPeriod > 0 && (epoch + 1) % s.dynasearchPeriod == 0) {
+            dynasearch.descend(state);
+        }
+        metrics.movesTried += L;
+        metrics.incrementalEvaluations += L;
+        metrics.epochSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - epochStart).count());
+        metrics.recordBest(state.getProfit());
+        if (state.getValue() - lastEpochProfit < gainThresh) {
+            ++rejectionCount;
+        } else {
+            rejectionCount = 0;
+        }
+        if (trace && epoch % s.epochPrintPeriod == 0) {
+            TraceEvent e = {TraceEvent::EPOCH, epoch, metrics.elapsedSeconds(), temperature, state.getProfit(),
+                            static_cast<double>(accepted) / L, rejectionCount};
+            trace->push(e);
+        }
+        temperature *= s.alpha; // Decrease temperature after each epoch
+        if (control && state.getProfit() > control->getIncumbentProfit()) {
+            control->offer(state.toOutput(), state.getProfit());
+        }
+        lastEpochProfit = state.getValue();
+        ++epoch;
+    }
+    if (s.dynasearchPeriod > 0) {
+        dynasearch.descend(state);
+    }
+    metrics.epochsToFreeze.push_back(epoch);
+    sequence = state.toOutput();
+    if (trace) {
+        TraceEvent e = {TraceEvent::FROZEN, epoch, metrics.elapsedSeconds(), temperature, state.getProfit(), 0.0,
+                        rejectionCount};
+        trace->push(e);
     }
 }
 
@@ -148,21 +442,80 @@ double SASolver::getInitTemperature(Output &output, std::mt19937_64 &gen, double
     int L = INIT_TEMP_SAMPLE_SIZE_FACTOR * n * n;
     int count = 0;
     double delta = 0.0;
-    int index1, index2;
     double currProfit = output.evaluate(input);
+    BatchEvaluator evaluator(input);
+    std::vector<std::pair<int, int>> swaps;
+    std::vector<double> newProfits;
 
     // Randomly perturb the current state L times to find the average decrease in profit.
-    for (int i = 0; i < L; ++i) {
-        double newProfit = perturb(output, index1, index2, gen);
-        if (newProfit < currProfit) {
-            ++count;
-            delta += currProfit - newProfit;
+    // Perturbations are drawn and evaluated INIT_TEMP_BATCH_SIZE at a time, in the same order.
+    for (int first = 0; first < L; first += INIT_TEMP_BATCH_SIZE) {
+        swaps.clear();
+        for (int i = first; i < std::min(L, first + INIT_TEMP_BATCH_SIZE); ++i) {
+            int index1 = uniformTaskNumDist(gen);
+            int index2 = uniformTaskNumDist(gen);
+            while (index2 == index1) {
+                index2 = uniformTaskNumDist(gen);
+            }
+            swaps.push_back(std::make_pair(index1, index2));
+        }
+        evaluator.evaluateSwaps(output, swaps, newProfits);
+        for (double newProfit : newProfits) {
+            if (newProfit < currProfit) {
+                ++count;
+                delta += currProfit - newProfit;
+            }
         }
-        output.swapTasks(index1, index2);
     }
     return delta / count / std::log(1 / initAccRate);
 }
 
+///
+/// \brief Large-instance counterpart of getInitTemperature. Samples windowed swaps with
+///        incremental evaluation instead of perturbing and evaluating the whole sequence.
+/// \param state: Current task sequence, left unchanged.
+/// \param gen: Random genreator.
+/// \param s: Settings for the solver, with a positive moveWindow.
+/// \return Initial temperature.
+///
+double SASolver::getInitTemperatureWindowed(const FixedScheduleState &state, std::mt19937_64 &gen, const Settings &s) {
+    int n = state.size();
+    int window = std::min(s.moveWindow, n - 1);
+    int active = std::min(n, state.cutoff() + window);
+    long long L = static_cast<long long>(INIT_TEMP_SAMPLE_SIZE_FACTOR * active * window);
+    long long count = 0;
+    double delta = 0.0;
+    int index1, index2;
+    for (long long i = 0; i < L; ++i) {
+        drawWindowedPair(active, window, index1, index2, gen);
+        FixedScheduleState::Value d = state.swapDelta(index1, index2);
+        if (d < 0) {
+            ++count;
+            delta -= FixedProfit::toDouble(d);
+        }
+    }
+    return count > 0 ? delta / count / std::log(1 / s.initAccRate) : PROFIT_GAIN_THRESH;
+}
+
+///
+/// \brief Draws two distinct positions for a windowed swap.
+/// \param active: The first position is drawn uniformly from [0, active).
+/// \param window: The second position is drawn uniformly from the positions at most
+///        this far from the first one, within the sequence.
+/// \param index1: Assigned the first position.
+/// \param index2: Assigned the second position.
+/// \param gen: Random generator.
+///
+void SASolver::drawWindowedPair(int active, int window, int &index1, int &index2, std::mt19937_64 &gen) {
+    index1 = std::uniform_int_distribution<int>(0, active - 1)(gen);
+    int lo = std::max(0, index1 - window);
+    int hi = std::min(input.size() - 1, index1 + window);
+    index2 = std::uniform_int_distribution<int>(lo, hi - 1)(gen);
+    if (index2 >= index1) {
+        ++index2;
+    }
+}
+
 ///
 /// \brief Returns the probability of accepting the new state given the
 ///        energies. If the energy of the new state is lower than the
@@ -197,36 +550,17 @@ double SASolver::perturb(Output &currOutput, int &index1, int &index2, std::mt19
 }
 
 ///
-/// \brief Generates a random task sequence for the Input.
-/// \param gen: Random generator.
-/// \return Random task sequence specified by an Output.
-///
-Output SASolver::generateRandomSequence(std::mt19937_64 &gen) {
-    std::vector<int> taskSequence;
-    for (int i = 0; i < input.size(); ++i) {
-        taskSequence.push_back(i);
-    }
-    std::shuffle(taskSequence.begin(), taskSequence.end(), gen);
-    return Output(taskSequence);
-}
-
-///
-/// \brief Returns the sequence with maximum profit in a std::vector of sequences.
-/// \param sequences: A vector of candidate sequences.
-/// \return Sequence with max profit in vector.
+/// \brief Returns the most profitable of the greedy sequences that take O(n log n) time,
+///        the starting point of large-instance mode.
+/// \return Greedy task sequence specified by an Output.
 ///
-Output SASolver::bestSequence(const std::vector<Output> &sequences) const {
-    double maxProfit = -1;
-    Output res;
-    for (const Output& seq : sequences) {
-        double profit = seq.evaluate(input);
-        if (profit > maxProfit) {
-            maxProfit = profit;
-            res = seq;
-        }
-    }
-    return res;
+Output SASolver::greedyStart() const {
+    GreedySolver gs(input);
+    std::vector<Output> sequences;
+    sequences.push_back(gs.solveDeadline());
+    sequences.push_back(gs.solveLeastOverdue());
+    sequences.push_back(gs.solveProfitRate());
+    sequences.push_back(gs.solveProfit());
+    sequences.push_back(gs.solveDuration());
+    return bestSequence(input, sequences);
 }
-
-
-
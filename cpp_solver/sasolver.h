@@ -2,6 +2,11 @@
 #define SASOLVER_H
 #include "input.h"
 #include "output.h"
+#include "schedulestate.h"
+#include "solver.h"
+#include "solvermetrics.h"
+#include "threadplacement.h"
+#include "trace.h"
 #include <random>
 
 ///
@@ -10,8 +15,10 @@
 /// \note Restarting does not work well in this implementation and the number of restarts
 ///       should be ignored and always set to zero (0).
 ///
-class SASolver
+class SASolver : public Solver
 {
+    friend class Microbenchmark;    // Times perturb, see benchmark/microbench.cpp.
+
 public:
     static const int NUM_THREADS = 8;
     struct Settings {
@@ -20,8 +27,13 @@ public:
         int maxRejections;      // Maximum number of epochs to be rejected before the system is deemed frozen.
         double epochSizeFactor; // Number of perturbations in each epoch == epochSizeFactor * numTasks * numTasks.
         double initAccRate;     // Approximate initial tempreature to achieve this initial acceptance rate for downhill movements.
-        bool verbose;           // Prints all details if set to true. May not work properly if NUM_THREADS is more than 1.
-        int epochPrintPeriod;   // Print epoch summary every this number of epochs.
+        bool verbose;           // Traces epoch progress to std::cout if set to true and traceFile is empty.
+        int epochPrintPeriod;   // Trace epoch summary every this number of epochs.
+        bool fixedPoint;        // Evaluate perturbations incrementally in fixed-point arithmetic (see profit.h).
+        std::string traceFile;  // Traces epoch progress to this file if not empty, regardless of verbose.
+        int moveWindow;         // If positive, large-instance mode: swap positions at most this far apart, see solveInstanceFixed.
+        ThreadPlacement::Policy placement;  // CPUs the threads are pinned to, see threadplacement.h.
+        int dynasearchPeriod;   // If positive, descend with Dynasearch every this number of epochs and once frozen.
 
         Settings(int maxRestarts = 0,
                  double alpha = 0.99,
@@ -29,7 +41,12 @@ public:
                  double epochSizeFactor = 1.0,
                  double initAccRate = 0.8,
                  bool verbose = false,
-                 int epochPrintPeriod = 1) {
+                 int epochPrintPeriod = 1,
+                 bool fixedPoint = false,
+                 const std::string& traceFile = "",
+                 int moveWindow = 0,
+                 ThreadPlacement::Policy placement = ThreadPlacement::NONE,
+                 int dynasearchPeriod = 0) {
             this->maxRestarts = maxRestarts;
             this->alpha = alpha;
             this->maxRejections = maxRejections;
@@ -37,6 +54,11 @@ public:
             this->initAccRate = initAccRate;
             this->verbose = verbose;
             this->epochPrintPeriod = epochPrintPeriod;
+            this->fixedPoint = fixedPoint;
+            this->traceFile = traceFile;
+            this->moveWindow = moveWindow;
+            this->placement = placement;
+            this->dynasearchPeriod = dynasearchPeriod;
         }
 
         friend std::ostream& operator <<(std::ostream& out, const Settings& s) {
@@ -46,34 +68,66 @@ public:
             out << "Initial acceptance rate == " << s.initAccRate << '\n';
             out << "Epoch size factor == " << s.epochSizeFactor << '\n';
             out << "Max epochs with no profit gain == " << s.maxRejections << '\n';
+            if (s.fixedPoint) {
+                out << "Fixed-point evaluation == 1\n";
+            }
+            if (s.moveWindow > 0) {
+                out << "Move window == " << s.moveWindow << '\n';
+            }
+            if (s.placement != ThreadPlacement::NONE) {
+                out << "Thread placement == " << ThreadPlacement::policyName(s.placement) << '\n';
+            }
+            if (s.dynasearchPeriod > 0) {
+                out << "Dynasearch period == " << s.dynasearchPeriod << '\n';
+            }
             return out;
         }
     };
 
 private:
     Input input;
+    Settings settings;
     const double INIT_TEMP_SAMPLE_SIZE_FACTOR = 2.0;    // Number of perturbations to try when determining
                                                         // initial temperature == INIT_TEMP_SAMPLE_SIZE_FACTOR * numTasks * numTasks.
+    const int INIT_TEMP_BATCH_SIZE = 256;               // Number of those perturbations evaluated together.
     const double PROFIT_GAIN_THRESH = 1e-3;             // No profit is considered gained if less than this value.
 
     std::uniform_int_distribution<int> uniformTaskNumDist;
     std::uniform_real_distribution<double> uniformRealDist;
 
+    std::vector<SolverMetrics> threadMetrics;           // Counters of each thread in the last call to solve().
+    TraceBuffer* trace = nullptr;                       // Trace events of the calling thread, nullptr if not tracing.
+
 public:
     SASolver();
-    SASolver(const Input& in);
+    SASolver(const Input& in, const Settings& s = Settings());
 
     Output solve(int seed = 0, Settings s = Settings());
+    Output solveFrom(const Output& initial, int seed = 0, Settings s = Settings());
+    const std::vector<SolverMetrics>& getMetrics() const;
+
+    std::string name() const override;
+    Output run(int seed, int numThreads, SolveControl& control) override;
 
 private:
-    void solveThread(Output& bestSequence, std::mt19937_64& gen, const Settings& s);
-    void solveInstance(Output& sequence, std::mt19937_64 &gen, Settings s);
+    void solveThread(Output& bestSequence, std::mt19937_64& gen, const Settings& s, SolverMetrics& metrics,
+                     TraceBuffer* traceBuffer, const Output* initial, int cpu) const;
+    void runThread(Output& bestSequence, std::mt19937_64& gen, SolveControl& control, const Output* initial,
+                   int cpu) const;
+    void solveInstance(Output& sequence, std::mt19937_64 &gen, Settings s, SolverMetrics& metrics,
+                       SolveControl* control = nullptr);
+    template <class Policy>
+    void anneal(Output& sequence, std::mt19937_64& gen, const Settings& s, SolverMetrics& metrics,
+                SolveControl* control);
+    void solveInstanceFixed(Output& sequence, std::mt19937_64 &gen, Settings s, SolverMetrics& metrics,
+                            SolveControl* control = nullptr);
 
     double getInitTemperature(Output &output, std::mt19937_64& gen, double initAccRate = 0.8);
+    double getInitTemperatureWindowed(const FixedScheduleState& state, std::mt19937_64& gen, const Settings& s);
+    void drawWindowedPair(int active, int window, int& index1, int& index2, std::mt19937_64& gen);
     double accProb(double eOld, double eNew, double t) const;
     double perturb(Output& currOutput, int& index1, int& index2, std::mt19937_64& gen);
-    Output generateRandomSequence(std::mt19937_64& gen);
-    Output bestSequence(const std::vector<Output>& sequences) const;
+    Output greedyStart() const;
 };
 
 #endif // SASOLVER_H
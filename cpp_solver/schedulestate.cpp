@@ -0,0 +1,376 @@
+#include "schedulestate.h"
+#include <algorithm>
+#include <cmath>
+
+template <class Arithmetic>
+BasicScheduleState<Arithmetic>::BasicScheduleState() : input(nullptr), horizon(MAX_TIME), profit() {}
+
+///
+/// \brief Initializes the state with the tasks of the Input in index order.
+/// \param in: Problem is specified by this Input.
+///
+template <class Arithmetic>
+BasicScheduleState<Arithmetic>::BasicScheduleState(const Input &in) : input(&in), horizon(in.getHorizon()), profit() {
+    assign(std::vector<int>());
+}
+
+///
+/// \brief Initializes the state with the task sequence of an Output.
+/// \param in: Problem is specified by this Input.
+/// \param output: Initial task sequence, possibly trimmed.
+///
+template <class Arithmetic>
+BasicScheduleState<Arithmetic>::BasicScheduleState(const Input &in, const Output &output)
+    : input(&in), horizon(in.getHorizon()), profit() {
+    assign(output.getSchedule());
+}
+
+///
+/// \brief Replaces the task sequence and recomputes all cached values. Tasks
+///        not present in the schedule are appended in index order. Buffers are
+///        reused, so assigning a schedule of the same size does not allocate.
+/// \param schedule: New 0-indexed task sequence.
+///
+template <class Arithmetic>
+void BasicScheduleState<Arithmetic>::assign(const std::vector<int> &schedule) {
+    int n = input->size();
+    sequence.resize(n);
+    completion.resize(n);
+    gains.resize(n);
+
+    // Use completion as scratch space to mark the tasks already placed.
+    std::fill(completion.begin(), completion.end(), 0);
+    int k = 0;
+    for (int task : schedule) {
+        if (task >= 0 && task < n && !completion[task] && k < n) {
+            completion[task] = 1;
+            sequence[k++] = task;
+        }
+    }
+    for (int task = 0; task < n; ++task) {
+        if (!completion[task]) {
+            sequence[k++] = task;
+        }
+    }
+    refresh();
+}
+
+///
+/// \brief Recomputes completion times, gains, and total profit from scratch.
+///        Useful to discard the rounding error accumulated by many moves.
+///
+template <class Arithmetic>
+void BasicScheduleState<Arithmetic>::refresh() {
+    profit = Value();
+    if (!sequence.empty()) {
+        recompute(0, size() - 1);
+        for (Value g : gains) {
+            profit += g;
+        }
+    }
+}
+
+///
+/// \brief Returns the number of tasks in the sequence.
+/// \return Number of tasks.
+///
+template <class Arithmetic>
+int BasicScheduleState<Arithmetic>::size() const {
+    return static_cast<int>(sequence.size());
+}
+
+///
+/// \brief Returns the task at position k.
+/// \param k: Position in the sequence.
+/// \return 0-indexed task.
+///
+template <class Arithmetic>
+int BasicScheduleState<Arithmetic>::taskAt(int k) const {
+    return sequence[k];
+}
+
+///
+/// \brief Returns the number of leading positions that finish within the global
+///        deadline. Moves with both indices greater than the cutoff never change the profit.
+/// \return Number of scheduled positions.
+///
+template <class Arithmetic>
+int BasicScheduleState<Arithmetic>::cutoff() const {
+    return static_cast<int>(std::upper_bound(completion.begin(), completion.end(), horizon) - completion.begin());
+}
+
+///
+/// \brief Returns the profit of the current sequence.
+/// \return Profit of the current sequence.
+///
+template <class Arithmetic>
+double BasicScheduleState<Arithmetic>::getProfit() const {
+    return Arithmetic::toDouble(profit);
+}
+
+///
+/// \brief Returns the profit of the current sequence in the representation of the arithmetic.
+/// \return Profit of the current sequence.
+///
+template <class Arithmetic>
+typename BasicScheduleState<Arithmetic>::Value BasicScheduleState<Arithmetic>::getValue() const {
+    return profit;
+}
+
+///
+/// \brief Get a constant reference to the task sequence.
+/// \return A constant reference to the 0-indexed task sequence.
+///
+template <class Arithmetic>
+const std::vector<int> &BasicScheduleState<Arithmetic>::getSequence() const {
+    return sequence;
+}
+
+///
+/// \brief Converts the state to an untrimmed Output.
+/// \return Output with the current task sequence.
+///
+template <class Arithmetic>
+Output BasicScheduleState<Arithmetic>::toOutput() const {
+    return Output(sequence);
+}
+
+///
+/// \brief Returns the change in profit if the tasks at positions i and j were swapped.
+///        Only positions between i and j are visited.
+/// \param i: First position.
+/// \param j: Second position.
+/// \return New profit minus current profit.
+///
+template <class Arithmetic>
+typename BasicScheduleState<Arithmetic>::Value BasicScheduleState<Arithmetic>::swapDelta(int i, int j) const {
+    if (i == j) {
+        return Value();
+    } else if (i > j) {
+        std::swap(i, j);
+    }
+    int start = startTime(i);
+    if (start >= horizon) {    // both positions are past the global deadline
+        return Value();
+    }
+    int a = sequence[i];
+    int b = sequence[j];
+    Value delta = gain(b, start + input->getDuration(b)) - gains[i];
+    int shift = input->getDuration(b) - input->getDuration(a);
+    if (shift != 0) {
+        for (int k = i + 1; k < j; ++k) {
+            if (completion[k] > horizon && completion[k] + shift > horizon) {
+                break;  // the rest of the range earns nothing either way
+            }
+            delta += gain(sequence[k], completion[k] + shift) - gains[k];
+        }
+    }
+    return delta + gain(a, completion[j]) - gains[j];
+}
+
+///
+/// \brief Returns the change in profit if the task at position from were removed and
+///        reinserted so that it ends up at position to. Only positions between from
+///        and to are visited.
+/// \param from: Current position of the task.
+/// \param to: Position of the task after the move.
+/// \return New profit minus current profit.
+///
+template <class Arithmetic>
+typename BasicScheduleState<Arithmetic>::Value BasicScheduleState<Arithmetic>::insertDelta(int from, int to) const {
+    if (from == to) {
+        return Value();
+    }
+    int x = sequence[from];
+    int dx = input->getDuration(x);
+    Value delta;
+    if (from < to) {
+        if (startTime(from) >= horizon) {
+            return Value();
+        }
+        delta = gain(x, completion[to]) - gains[from];
+        for (int k = from + 1; k <= to; ++k) {
+            if (completion[k] - dx > horizon) {
+                break;
+            }
+            delta += gain(sequence[k], completion[k] - dx) - gains[k];
+        }
+    } else {
+        int start = startTime(to);
+        if (start >= horizon) {
+            return Value();
+        }
+        delta = gain(x, start + dx) - gains[from];
+        for (int k = to; k < from; ++k) {
+            if (completion[k] > horizon) {
+                break;
+            }
+            delta += gain(sequence[k], completion[k] + dx) - gains[k];
+        }
+    }
+    return delta;
+}
+
+///
+/// \brief Returns the change in profit if the length tasks starting at position from
+///        were removed and reinserted in the same order so that the first of them ends
+///        up at position to. Only positions between the old and the new block are visited.
+/// \param from: Current position of the first task of the block.
+/// \param length: Number of tasks in the block.
+/// \param to: Position of the first task of the block after the move, at most size() - length.
+/// \return New profit minus current profit.
+///
+template <class Arithmetic>
+typename BasicScheduleState<Arithmetic>::Value BasicScheduleState<Arithmetic>::segmentDelta(int from, int length,
+                                                                                            int to) const {
+    if (from == to) {
+        return Value();
+    }
+    int last = from + length - 1;
+    int blockDuration = completion[last] - startTime(from);
+    int time;   // start time of the block after the move
+    Value delta = Value();
+    if (from < to) {
+        if (startTime(from) >= horizon) {
+            return Value();
+        }
+        for (int k = last + 1; k < to + length; ++k) {
+            if (completion[k] - blockDuration > horizon) {
+                break;
+            }
+            delta += gain(sequence[k], completion[k] - blockDuration) - gains[k];
+        }
+        time = completion[to + length - 1] - blockDuration;
+    } else {
+        time = startTime(to);
+        if (time >= horizon) {
+            return Value();
+        }
+        for (int k = to; k < from; ++k) {
+            if (completion[k] > horizon) {
+                break;
+            }
+            delta += gain(sequence[k], completion[k] + blockDuration) - gains[k];
+        }
+    }
+    for (int k = from; k <= last; ++k) {
+        time += input->getDuration(sequence[k]);
+        delta += gain(sequence[k], time) - gains[k];
+    }
+    return delta;
+}
+
+///
+/// \brief Swaps the tasks at positions i and j and updates the cached values.
+/// \param i: First position.
+/// \param j: Second position.
+/// \return Change in profit.
+///
+template <class Arithmetic>
+typename BasicScheduleState<Arithmetic>::Value BasicScheduleState<Arithmetic>::applySwap(int i, int j) {
+    if (i == j) {
+        return Value();
+    } else if (i > j) {
+        std::swap(i, j);
+    }
+    std::swap(sequence[i], sequence[j]);
+    Value delta = recompute(i, j);
+    profit += delta;
+    return delta;
+}
+
+///
+/// \brief Moves the task at position from to position to, shifting the tasks
+///        in between by one position, and updates the cached values.
+/// \param from: Current position of the task.
+/// \param to: Position of the task after the move.
+/// \return Change in profit.
+///
+template <class Arithmetic>
+typename BasicScheduleState<Arithmetic>::Value BasicScheduleState<Arithmetic>::applyInsert(int from, int to) {
+    if (from == to) {
+        return Value();
+    }
+    int x = sequence[from];
+    if (from < to) {
+        std::copy(sequence.begin() + from + 1, sequence.begin() + to + 1, sequence.begin() + from);
+    } else {
+        std::copy_backward(sequence.begin() + to, sequence.begin() + from, sequence.begin() + from + 1);
+    }
+    sequence[to] = x;
+    Value delta = recompute(std::min(from, to), std::max(from, to));
+    profit += delta;
+    return delta;
+}
+
+///
+/// \brief Moves the length tasks starting at position from so that the first of them
+///        ends up at position to, keeping their order, and updates the cached values.
+/// \param from: Current position of the first task of the block.
+/// \param length: Number of tasks in the block.
+/// \param to: Position of the first task of the block after the move, at most size() - length.
+/// \return Change in profit.
+///
+template <class Arithmetic>
+typename BasicScheduleState<Arithmetic>::Value BasicScheduleState<Arithmetic>::applySegment(int from, int length,
+                                                                                            int to) {
+    if (from == to) {
+        return Value();
+    }
+    if (from < to) {
+        std::rotate(sequence.begin() + from, sequence.begin() + from + length, sequence.begin() + to + length);
+    } else {
+        std::rotate(sequence.begin() + to, sequence.begin() + from, sequence.begin() + from + length);
+    }
+    Value delta = recompute(std::min(from, to), std::max(from, to) + length - 1);
+    profit += delta;
+    return delta;
+}
+
+///
+/// \brief Returns the profit earned by a task finishing at the given time.
+/// \param task: 0-indexed task.
+/// \param time: Completion time of the task.
+/// \return Profit earned, zero if the task finishes after the global deadline.
+///
+template <class Arithmetic>
+typename BasicScheduleState<Arithmetic>::Value BasicScheduleState<Arithmetic>::gain(int task, int time) const {
+    if (time > horizon) {
+        return Value();
+    }
+    return Arithmetic::gain(*input, task, time - input->getDeadline(task));
+}
+
+///
+/// \brief Recomputes completion times and gains of positions lo to hi, assuming
+///        the completion time of every position outside the range is unchanged.
+/// \param lo: First position to recompute.
+/// \param hi: Last position to recompute.
+/// \return Sum of new gains minus sum of old gains within the range.
+///
+template <class Arithmetic>
+typename BasicScheduleState<Arithmetic>::Value BasicScheduleState<Arithmetic>::recompute(int lo, int hi) {
+    int time = startTime(lo);
+    Value delta = Value();
+    for (int k = lo; k <= hi; ++k) {
+        time += input->getDuration(sequence[k]);
+        completion[k] = time;
+        Value g = gain(sequence[k], time);
+        delta += g - gains[k];
+        gains[k] = g;
+    }
+    return delta;
+}
+
+///
+/// \brief Returns the time at which the task at position k starts.
+/// \param k: Position in the sequence.
+/// \return Completion time of the previous position, 0 for the first position.
+///
+template <class Arithmetic>
+int BasicScheduleState<Arithmetic>::startTime(int k) const {
+    return k > 0 ? completion[k - 1] : 0;
+}
+
+template class BasicScheduleState<FloatingProfit>;
+template class BasicScheduleState<FixedProfit>;
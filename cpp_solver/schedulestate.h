@@ -0,0 +1,66 @@
+#ifndef SCHEDULESTATE_H
+#define SCHEDULESTATE_H
+#include <vector>
+#include "input.h"
+#include "output.h"
+#include "profit.h"
+
+///
+/// \brief A ScheduleState is a complete task sequence for an Input together with the
+///        completion time and the profit earned at every position. Caching these allows
+///        swap and insertion moves to be evaluated by looking only at the positions
+///        between the two indices, since every task outside of that range keeps its
+///        completion time. Segment (or-opt) moves generalize insertion to a block of
+///        consecutive tasks. Tasks missing from the sequence it is built from are
+///        appended at the end, so a trimmed Output can be loaded as well.
+///        Profits are computed with the Arithmetic policy, either FloatingProfit
+///        (ScheduleState) or FixedProfit (FixedScheduleState), see profit.h.
+/// \note The state keeps a pointer to the Input, which must outlive the state.
+///
+template <class Arithmetic>
+class BasicScheduleState
+{
+public:
+    typedef typename Arithmetic::Value Value;
+
+private:
+    const Input* input;
+    int horizon;                    // Global deadline of the Input.
+    std::vector<int> sequence;      // sequence[k] == task at position k
+    std::vector<int> completion;    // completion[k] == time at which the task at position k finishes
+    std::vector<Value> gains;       // gains[k] == profit earned by the task at position k
+    Value profit;
+
+public:
+    BasicScheduleState();
+    BasicScheduleState(const Input& in);
+    BasicScheduleState(const Input& in, const Output& output);
+
+    void assign(const std::vector<int>& schedule);
+    void refresh();
+
+    int size() const;
+    int taskAt(int k) const;
+    int cutoff() const;
+    double getProfit() const;
+    Value getValue() const;
+    const std::vector<int>& getSequence() const;
+    Output toOutput() const;
+
+    Value swapDelta(int i, int j) const;
+    Value insertDelta(int from, int to) const;
+    Value segmentDelta(int from, int length, int to) const;
+    Value applySwap(int i, int j);
+    Value applyInsert(int from, int to);
+    Value applySegment(int from, int length, int to);
+
+private:
+    Value gain(int task, int time) const;
+    Value recompute(int lo, int hi);
+    int startTime(int k) const;
+};
+
+typedef BasicScheduleState<FloatingProfit> ScheduleState;
+typedef BasicScheduleState<FixedProfit> FixedScheduleState;
+
+#endif // SCHEDULESTATE_H
@@ -0,0 +1,237 @@
+#include "solver.h"
+#include "batcheval.h"
+#include <algorithm>
+#include <cctype>
+
+///
+/// \brief Returns a short name of an engine for logs.
+/// \param engine: Solver engine.
+/// \return Name of the engine.
+///
+std::string engineName(Engine engine) {
+    switch (engine) {
+    case SIMULATED_ANNEALING:
+        return "SA";
+    case TABU_SEARCH:
+        return "Tabu";
+    case LATE_ACCEPTANCE:
+        return "LAHC";
+    case MEMETIC:
+        return "Memetic";
+    case DYNASEARCH:
+        return "Dynasearch";
+    case LARGE_NEIGHBOURHOOD:
+        return "LNS";
+    case VARIABLE_NEIGHBOURHOOD:
+        return "VNS";
+    case GREEDY:
+        return "Greedy";
+    case NAIVE:
+        return "Naive";
+    default:
+        return "Unknown";
+    }
+}
+
+///
+/// \brief Looks up an engine by the name engineName returns, ignoring case.
+/// \param name: Name of the engine.
+/// \param engine: Assigned the engine if found.
+/// \return False if no engine has the name.
+///
+bool engineFromName(const std::string &name, Engine &engine) {
+    for (int e = SIMULATED_ANNEALING; e <= NAIVE; ++e) {
+        std::string candidate = engineName(static_cast<Engine>(e));
+        if (candidate.size() == name.size()
+                && std::equal(name.begin(), name.end(), candidate.begin(),
+                              [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
+            engine = static_cast<Engine>(e);
+            return true;
+        }
+    }
+    return false;
+}
+
+///
+/// \brief Initializes a SolveControl without a deadline.
+///
+SolveControl::SolveControl() : startTime(std::chrono::steady_clock::now()), hasDeadline(false),
+    stopFlag(false), incumbentProfit(-1.0) {}
+
+///
+/// \brief Initializes a SolveControl that asks solvers to stop after timeBudget seconds.
+/// \param timeBudget: Wall-clock time budget in seconds.
+///
+SolveControl::SolveControl(double timeBudget) : SolveControl() {
+    hasDeadline = true;
+    deadline = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(timeBudget));
+}
+
+///
+/// \brief Returns whether solvers should stop searching.
+/// \return True if a stop was requested or the deadline has passed.
+///
+bool SolveControl::shouldStop() const {
+    return stopFlag.load(std::memory_order_relaxed)
+            || (hasDeadline && std::chrono::steady_clock::now() >= deadline);
+}
+
+///
+/// \brief Asks all solvers sharing this SolveControl to stop.
+///
+void SolveControl::requestStop() {
+    stopFlag.store(true);
+}
+
+///
+/// \brief Returns the number of seconds since the SolveControl was created.
+/// \return Elapsed wall-clock time in seconds.
+///
+double SolveControl::elapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+///
+/// \brief Replaces the incumbent if the offered Output is more profitable.
+/// \param output: Candidate Output.
+/// \param profit: Profit of the candidate.
+/// \return True if the incumbent was replaced.
+///
+bool SolveControl::offer(const Output &output, double profit) {
+    if (profit <= incumbentProfit.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    if (profit <= incumbentProfit.load()) {
+        return false;
+    }
+    incumbent = output;
+    incumbentProfit.store(profit);
+    timeline.push_back(std::make_pair(elapsedSeconds(), profit));
+    lock.unlock();
+    notifyListener();
+    return true;
+}
+
+///
+/// \brief Passes the newest incumbent to the listener, outside the lock of the incumbent,
+///        so that a slow listener does not hold up the solvers that offer incumbents. Only
+///        one thread runs the listener at a time; another thread that offers meanwhile
+///        returns at once and the running thread passes its incumbent on next, skipping
+///        incumbents that were improved on before the listener got to them.
+///
+void SolveControl::notifyListener() {
+    while (true) {
+        std::unique_lock<std::mutex> notifying(listenerMutex, std::try_to_lock);
+        if (!notifying.owns_lock()) {
+            return;
+        }
+        while (true) {
+            Output output;
+            double profit;
+            std::function<void(const Output&, double)> call;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!listener || incumbentProfit.load() <= notifiedProfit) {
+                    break;
+                }
+                output = incumbent;
+                profit = incumbentProfit.load();
+                notifiedProfit = profit;
+                call = listener;
+            }
+            call(output, profit);
+        }
+        notifying.unlock();
+
+        // An incumbent offered just before the unlock found the listener busy, pass it on here.
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!listener || incumbentProfit.load() <= notifiedProfit) {
+            return;
+        }
+    }
+}
+
+///
+/// \brief Copies the incumbent.
+/// \param output: Assigned to be the incumbent.
+/// \param profit: Assigned to be the profit of the incumbent.
+/// \return False if nothing has been offered yet, in which case the arguments are unchanged.
+///
+bool SolveControl::getIncumbent(Output &output, double &profit) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (incumbentProfit.load() < 0) {
+        return false;
+    }
+    output = incumbent;
+    profit = incumbentProfit.load();
+    return true;
+}
+
+///
+/// \brief Returns the profit of the incumbent without locking.
+/// \return Profit of the incumbent, negative if nothing has been offered yet.
+///
+double SolveControl::getIncumbentProfit() const {
+    return incumbentProfit.load(std::memory_order_relaxed);
+}
+
+///
+/// \brief Returns the anytime curve of the incumbent.
+/// \return (seconds since creation, profit) at every improvement of the incumbent, in time order.
+///
+std::vector<std::pair<double, double>> SolveControl::getTimeline() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return timeline;
+}
+
+///
+/// \brief Sets a function called with new incumbents and their profits, in the order the
+///        incumbents improve. It runs on the thread of a solver that offered an incumbent,
+///        but not while the incumbent is locked, and never on two threads at once. If
+///        incumbents improve faster than it returns, it only sees the newest of them.
+///        Waits for a running call to return, so the previous listener is never called
+///        after setListener returns.
+/// \param listener: Function to call, or an empty function to stop calling.
+///
+void SolveControl::setListener(const std::function<void(const Output &, double)> &listener) {
+    std::lock_guard<std::mutex> notifying(listenerMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    this->listener = listener;
+}
+
+///
+/// \brief Generates a random task sequence for the Input.
+/// \param in: Problem is specified by this Input.
+/// \param gen: Random generator.
+/// \return Random task sequence specified by an Output.
+///
+Output Solver::randomSequence(const Input &in, std::mt19937_64 &gen) {
+    std::vector<int> taskSequence;
+    for (int i = 0; i < in.size(); ++i) {
+        taskSequence.push_back(i);
+    }
+    std::shuffle(taskSequence.begin(), taskSequence.end(), gen);
+    return Output(taskSequence);
+}
+
+///
+/// \brief Returns the sequence with maximum profit in a std::vector of sequences.
+/// \param in: Problem is specified by this Input.
+/// \param sequences: A vector of candidate sequences.
+/// \return Sequence with max profit in vector.
+///
+Output Solver::bestSequence(const Input &in, const std::vector<Output> &sequences) {
+    double maxProfit = -1;
+    Output res;
+    std::vector<double> profits;
+    BatchEvaluator(in).evaluate(sequences, profits);
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        if (profits[i] > maxProfit) {
+            maxProfit = profits[i];
+            res = sequences[i];
+        }
+    }
+    return res;
+}
@@ -0,0 +1,83 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "input.h"
+#include "output.h"
+
+///
+/// \brief Solver engines that can be selected at runtime.
+///
+enum Engine { SIMULATED_ANNEALING, TABU_SEARCH, LATE_ACCEPTANCE, MEMETIC, DYNASEARCH, LARGE_NEIGHBOURHOOD, VARIABLE_NEIGHBOURHOOD, GREEDY, NAIVE };
+
+std::string engineName(Engine engine);
+bool engineFromName(const std::string& name, Engine& engine);
+
+///
+/// \brief A SolveControl is shared by all solvers working on the same Input at the
+///        same time. It holds the wall-clock deadline, a stop flag, and the best Output
+///        found so far by any of them (the incumbent). Solvers poll shouldStop() at
+///        convenient points, offer every improvement, and may restart from the incumbent.
+///        Offered Outputs must be untrimmed, so that solvers can restart from them.
+///
+class SolveControl
+{
+private:
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point deadline;
+    bool hasDeadline;
+    std::atomic<bool> stopFlag;
+    std::atomic<double> incumbentProfit;
+
+    mutable std::mutex mutex;
+    Output incumbent;
+    std::vector<std::pair<double, double>> timeline;    // (elapsed seconds, profit) every time the incumbent improved.
+    std::function<void(const Output&, double)> listener;
+    double notifiedProfit = -1.0;       // Profit of the last incumbent passed to the listener.
+    std::mutex listenerMutex;           // Held while the listener runs, outside mutex.
+
+public:
+    SolveControl();
+    SolveControl(double timeBudget);
+
+    bool shouldStop() const;
+    void requestStop();
+    double elapsedSeconds() const;
+
+    bool offer(const Output& output, double profit);
+    bool getIncumbent(Output& output, double& profit) const;
+    double getIncumbentProfit() const;
+    std::vector<std::pair<double, double>> getTimeline() const;
+    void setListener(const std::function<void(const Output&, double)>& listener);
+
+private:
+    void notifyListener();
+};
+
+///
+/// \brief Common interface of all solvers. Every solver is constructed from an Input
+///        and keeps its own settings; run() searches until the solver is done or the
+///        SolveControl asks it to stop, offering improvements along the way. Solvers share
+///        the helpers that start their threads from random sequences and pick the best of
+///        their results.
+///
+class Solver
+{
+public:
+    virtual ~Solver() {}
+
+    virtual std::string name() const = 0;
+    virtual Output run(int seed, int numThreads, SolveControl& control) = 0;
+
+protected:
+    static Output randomSequence(const Input& in, std::mt19937_64& gen);
+    static Output bestSequence(const Input& in, const std::vector<Output>& sequences);
+};
+
+#endif // SOLVER_H
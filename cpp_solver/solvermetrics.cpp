@@ -0,0 +1,104 @@
+#include "solvermetrics.h"
+#include <algorithm>
+#include <fstream>
+
+SolverMetrics::SolverMetrics() : start(std::chrono::steady_clock::now()) {}
+
+///
+/// \brief Returns the number of seconds since the solve started.
+/// \return Elapsed wall-clock time in seconds.
+///
+double SolverMetrics::elapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+///
+/// \brief Appends a point to the best-profit timeline if the profit is an improvement.
+/// \param profit: Best profit of the thread so far.
+///
+void SolverMetrics::recordBest(double profit) {
+    if (timeline.empty() || profit > timeline.back().second) {
+        timeline.push_back(std::make_pair(elapsedSeconds(), profit));
+    }
+}
+
+///
+/// \brief Sends the counters as a JSON object to the output stream.
+/// \param out: output stream.
+/// \param m: Metrics to print.
+/// \return R/W reference to the output stream.
+///
+std::ostream& operator <<(std::ostream& out, const SolverMetrics& m) {
+    double epochTotal = 0.0;
+    for (double t : m.epochSeconds) {
+        epochTotal += t;
+    }
+    out << "{\"cpu\": " << m.cpu
+        << ", \"movesTried\": " << m.movesTried
+        << ", \"acceptedUphill\": " << m.acceptedUphill
+        << ", \"acceptedNeutral\": " << m.acceptedNeutral
+        << ", \"acceptedDownhill\": " << m.acceptedDownhill
+        << ", \"fullEvaluations\": " << m.fullEvaluations
+        << ", \"incrementalEvaluations\": " << m.incrementalEvaluations
+        << ", \"epochs\": " << m.epochSeconds.size()
+        << ", \"epochSecondsTotal\": " << epochTotal
+        << ", \"epochSecondsMax\": "
+        << (m.epochSeconds.empty() ? 0.0 : *std::max_element(m.epochSeconds.begin(), m.epochSeconds.end()))
+        << ", \"epochsToFreeze\": [";
+    for (size_t k = 0; k < m.epochsToFreeze.size(); ++k) {
+        out << (k ? ", " : "") << m.epochsToFreeze[k];
+    }
+    out << "], \"bestProfit\": " << (m.timeline.empty() ? 0.0 : m.timeline.back().second) << '}';
+    return out;
+}
+
+///
+/// \brief Writes a JSON report with the counters of every thread, their totals, and
+///        the best-profit timeline over all threads.
+/// \param fileName: Directory to the report file. Overwrites if file already exists.
+/// \param instance: Name of the instance.
+/// \param solver: Name of the solver.
+/// \param wallSeconds: Wall-clock time of the whole solve.
+/// \param threads: Metrics of each thread.
+///
+void writeMetricsReport(const std::string &fileName, const std::string &instance, const std::string &solver,
+                        double wallSeconds, const std::vector<SolverMetrics> &threads) {
+    SolverMetrics total;
+    std::vector<std::pair<double, double>> points;
+    for (const SolverMetrics& m : threads) {
+        total.movesTried += m.movesTried;
+        total.acceptedUphill += m.acceptedUphill;
+        total.acceptedNeutral += m.acceptedNeutral;
+        total.acceptedDownhill += m.acceptedDownhill;
+        total.fullEvaluations += m.fullEvaluations;
+        total.incrementalEvaluations += m.incrementalEvaluations;
+        total.epochSeconds.insert(total.epochSeconds.end(), m.epochSeconds.begin(), m.epochSeconds.end());
+        total.epochsToFreeze.insert(total.epochsToFreeze.end(), m.epochsToFreeze.begin(), m.epochsToFreeze.end());
+        points.insert(points.end(), m.timeline.begin(), m.timeline.end());
+    }
+    // Best profit over all threads as a function of time
+    std::sort(points.begin(), points.end());
+    for (const std::pair<double, double>& p : points) {
+        if (total.timeline.empty() || p.second > total.timeline.back().second) {
+            total.timeline.push_back(p);
+        }
+    }
+
+    std::fstream fs(fileName, std::fstream::out);
+    fs << "{\n";
+    fs << "  \"instance\": \"" << instance << "\",\n";
+    fs << "  \"solver\": \"" << solver << "\",\n";
+    fs << "  \"wallSeconds\": " << wallSeconds << ",\n";
+    fs << "  \"total\": " << total << ",\n";
+    fs << "  \"threads\": [\n";
+    for (size_t k = 0; k < threads.size(); ++k) {
+        fs << "    " << threads[k] << (k + 1 < threads.size() ? ",\n" : "\n");
+    }
+    fs << "  ],\n";
+    fs << "  \"bestProfitTimeline\": [";
+    for (size_t k = 0; k < total.timeline.size(); ++k) {
+        fs << (k ? ", " : "") << '[' << total.timeline[k].first << ", " << total.timeline[k].second << ']';
+    }
+    fs << "]\n}\n";
+    fs.close();
+}
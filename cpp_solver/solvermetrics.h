@@ -0,0 +1,49 @@
+#ifndef SOLVERMETRICS_H
+#define SOLVERMETRICS_H
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+///
+/// \brief Counters collected by a single solver thread. Each thread owns its own
+///        SolverMetrics, so counting needs no synchronization; the counters of all
+///        threads are combined once the threads are joined. In this file, uphill means
+///        the profit increases and downhill means the profit decreases.
+///
+struct SolverMetrics {
+    std::chrono::steady_clock::time_point start;    // Time the solve started, shared by all threads.
+    int cpu = -1;                           // CPU the thread was pinned to, -1 if not pinned.
+
+    long long movesTried = 0;               // Perturbations proposed.
+    long long acceptedUphill = 0;           // Accepted perturbations that increased the profit.
+    long long acceptedNeutral = 0;          // Accepted perturbations that left the profit unchanged.
+    long long acceptedDownhill = 0;         // Accepted perturbations that decreased the profit.
+    long long fullEvaluations = 0;          // Calls to Output::evaluate.
+    long long incrementalEvaluations = 0;   // Move deltas computed by a ScheduleState.
+    std::vector<double> epochSeconds;       // Wall-clock time of each epoch.
+    std::vector<int> epochsToFreeze;        // Number of epochs of each annealing run.
+    std::vector<std::pair<double, double>> timeline;    // (seconds since start, best profit) at every improvement.
+
+    SolverMetrics();
+
+    double elapsedSeconds() const;
+    void recordAccepted(double delta) {
+        if (delta > 0) {
+            ++acceptedUphill;
+        } else if (delta < 0) {
+            ++acceptedDownhill;
+        } else {
+            ++acceptedNeutral;
+        }
+    }
+    void recordBest(double profit);
+
+    friend std::ostream& operator <<(std::ostream& out, const SolverMetrics& m);
+};
+
+void writeMetricsReport(const std::string& fileName, const std::string& instance, const std::string& solver,
+                        double wallSeconds, const std::vector<SolverMetrics>& threads);
+
+#endif // SOLVERMETRICS_H
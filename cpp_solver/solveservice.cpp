@@ -0,0 +1,261 @@
+#include "solveservice.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+///
+/// \brief Starts the request workers.
+/// \param numCores: Number of cores shared by all requests, at least one.
+/// \param portfolio: Portfolio that solves requests without an engine, and whose
+///        configurations hold the settings of single-engine requests.
+///
+SolveService::SolveService(int numCores, const Portfolio &portfolio)
+    : numCores(std::max(1, numCores)), portfolio(portfolio), workers(std::max(1, numCores)),
+      freeCores(std::max(1, numCores)) {}
+
+///
+/// \brief Answers the requests of one client until the end of its stream or a quit
+///        message, then waits for its running requests to finish. Several clients may be
+///        served at the same time on different threads, sharing the cores of the service.
+/// \param read: Reads the messages of the client.
+/// \param write: Writes replies to the client, must be safe to call from several threads.
+///
+void SolveService::serve(const LineReader &read, const LineWriter &write) {
+    long long client;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        client = nextClient++;
+    }
+    std::mutex pendingMutex;
+    std::condition_variable pendingDone;
+    int pending = 0;
+    std::string line;
+    while (read(line)) {
+        std::istringstream words(line);
+        std::string command, id;
+        words >> command >> id;
+        if (command.empty()) {
+            continue;
+        } else if (command == "quit") {
+            break;
+        } else if (command == "stop") {
+            if (!stop(client, id)) {
+                write("error " + id + " no such request");
+            }
+        } else if (command == "solve") {
+            Request request;
+            std::string error;
+            if (!parseRequest(line, read, request, error)) {
+                write("error " + (id.empty() ? "-" : id) + " " + error);
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(pendingMutex);
+                ++pending;
+            }
+            submit(client, request, write, [&] {
+                std::lock_guard<std::mutex> lock(pendingMutex);
+                if (--pending == 0) {
+                    pendingDone.notify_all();
+                }
+            });
+        } else {
+            write("error - unknown command " + command);
+        }
+    }
+    std::unique_lock<std::mutex> lock(pendingMutex);
+    pendingDone.wait(lock, [&] { return pending == 0; });
+}
+
+///
+/// \brief Queues a request on the request workers and returns immediately. The time
+///        budget of the request starts now, so it includes the time spent waiting for cores.
+/// \param client: Token of the client, which scopes the id of the request.
+/// \param request: Request to solve.
+/// \param write: Receives the replies to the request.
+/// \param finished: Called once the final reply has been written.
+///
+void SolveService::submit(long long client, const Request &request, const LineWriter &write,
+                          const std::function<void ()> &finished) {
+    std::shared_ptr<SolveControl> control = std::make_shared<SolveControl>(request.timeBudget);
+    std::pair<long long, std::string> key(client, request.id);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running.count(key)) {
+            write("error " + request.id + " request id already in use");
+            finished();
+            return;
+        }
+        running[key] = control;
+    }
+    workers.submit([this, key, request, control, write, finished] {
+        solve(request, *control, write);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running.erase(key);
+        }
+        finished();
+    });
+}
+
+///
+/// \brief Asks a queued or running request to stop. Its final reply is written as usual.
+/// \param client: Token of the client that submitted the request.
+/// \param id: Id of the request.
+/// \return False if the client has no request with the id.
+///
+bool SolveService::stop(long long client, const std::string &id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<std::pair<long long, std::string>, std::shared_ptr<SolveControl>>::iterator it
+        = running.find(std::make_pair(client, id));
+    if (it == running.end()) {
+        return false;
+    }
+    it->second->requestStop();
+    return true;
+}
+
+///
+/// \brief Parses a solve message, reading the input that follows it.
+/// \param header: First line of the message.
+/// \param read: Reads the lines of the input.
+/// \param request: Assigned the request.
+/// \param error: Assigned a description of the problem if the message is malformed.
+/// \return False if the message is malformed or its input violates the spec. The input
+///         is read in full whenever its number of tasks can be read, so the next message
+///         is read correctly.
+///
+bool SolveService::parseRequest(const std::string &header, const LineReader &read, Request &request,
+                                std::string &error) {
+    std::istringstream words(header);
+    std::string command, option;
+    words >> command >> request.id;
+    int horizon = MAX_TIME;
+    while (words >> option && error.empty()) {
+        size_t equals = option.find('=');
+        std::string key = option.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : option.substr(equals + 1);
+        if (key == "budget" && std::atof(value.c_str()) > 0) {
+            request.timeBudget = std::atof(value.c_str());
+        } else if (key == "cores" && std::atoi(value.c_str()) > 0) {
+            request.cores = std::atoi(value.c_str());
+        } else if (key == "engine" && value == "portfolio") {
+            request.usePortfolio = true;
+        } else if (key == "engine" && engineFromName(value, request.engine)) {
+            request.usePortfolio = false;
+        } else if (key == "seed" && !value.empty()) {
+            request.seed = std::atoi(value.c_str());
+        } else if (key == "horizon" && std::atoi(value.c_str()) > 0) {
+            horizon = std::atoi(value.c_str());
+        } else if (key == "progress" && !value.empty()) {
+            request.progressPeriod = std::atof(value.c_str());
+        } else {
+            error = "invalid option " + option;
+        }
+    }
+    if (request.id.empty()) {
+        error = "missing request id";
+    }
+
+    std::string line, text;
+    int n = -1;
+    if (!read(line) || !(std::istringstream(line) >> n) || n < 0) {
+        error = "expected the number of tasks";
+        return false;
+    }
+    text = line + '\n';
+    for (int i = 0; i < n; ++i) {
+        if (!read(line)) {
+            error = "input ends after " + std::to_string(i) + " tasks";
+            return false;
+        }
+        text += line + '\n';
+    }
+    if (!error.empty()) {
+        return false;
+    }
+    request.input = Input::fromText(text, request.id, 0, horizon);
+    if (!request.input.isValid()) {
+        error = request.input.getError();
+        return false;
+    }
+    return true;
+}
+
+///
+/// \brief Formats an Output for a reply.
+/// \param input: Problem is specified by this Input.
+/// \param output: Untrimmed Output.
+/// \return "<profit> <numTasks> <tasks...>" with 1-indexed tasks, trimmed to the horizon.
+///
+std::string SolveService::formatSchedule(const Input &input, const Output &output) {
+    Output trimmed = output;
+    trimmed.trim(input);
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(6) << trimmed.evaluate(input) << ' ' << trimmed.size();
+    for (int task : trimmed.getSchedule()) {
+        out << ' ' << task + 1;
+    }
+    return out.str();
+}
+
+///
+/// \brief Solves a request on the calling request worker, streaming its replies.
+/// \param request: Request to solve.
+/// \param control: Deadline and stop flag of the request.
+/// \param write: Receives the replies to the request.
+///
+void SolveService::solve(const Request &request, SolveControl &control, const LineWriter &write) {
+    int cores = acquireCores(request.cores);
+    write("accepted " + request.id + " cores=" + std::to_string(cores));
+    double lastReport = -request.progressPeriod;
+    control.setListener([&](const Output& output, double) {
+        double seconds = control.elapsedSeconds();
+        if (seconds - lastReport >= request.progressPeriod) {
+            lastReport = seconds;
+            std::ostringstream out;
+            out << "best " << request.id << ' ' << std::fixed << std::setprecision(3) << seconds << ' '
+                << formatSchedule(request.input, output);
+            write(out.str());
+        }
+    });
+
+    Output best = request.usePortfolio ? portfolio.solve(request.input, cores, control, request.seed)
+                                       : portfolio.solveWith(request.engine, request.input, cores, control, request.seed);
+    control.setListener(std::function<void(const Output&, double)>());
+    releaseCores(cores);
+
+    std::ostringstream out;
+    out << "done " << request.id << ' ' << std::fixed << std::setprecision(3) << control.elapsedSeconds() << ' '
+        << formatSchedule(request.input, best);
+    write(out.str());
+}
+
+///
+/// \brief Blocks until the cores are free and all earlier requests have been granted theirs.
+/// \param cores: Number of cores requested, lowered to the cores of the service.
+/// \return Number of cores granted.
+///
+int SolveService::acquireCores(int cores) {
+    cores = std::min(std::max(1, cores), numCores);
+    std::unique_lock<std::mutex> lock(mutex);
+    long long ticket = nextTicket++;
+    changed.wait(lock, [&] { return servedTicket == ticket && freeCores >= cores; });
+    freeCores -= cores;
+    ++servedTicket;
+    changed.notify_all();
+    return cores;
+}
+
+///
+/// \brief Returns cores granted by acquireCores.
+/// \param cores: Number of cores granted.
+///
+void SolveService::releaseCores(int cores) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeCores += cores;
+    }
+    changed.notify_all();
+}
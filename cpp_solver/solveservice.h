@@ -0,0 +1,88 @@
+#ifndef SOLVESERVICE_H
+#define SOLVESERVICE_H
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "input.h"
+#include "portfolio.h"
+#include "solver.h"
+#include "threadpool.h"
+
+///
+/// \brief Long-lived solver that answers solve requests received as text, so that a
+///        pipeline pays for process startup and thread creation once instead of per batch.
+///        Requests run concurrently on a warm pool of request workers. Every request is
+///        granted the number of cores it asks for, in arrival order, before it starts, and
+///        the cores it holds never exceed the cores of the service. Best-so-far schedules
+///        are streamed back while a request runs, followed by the final schedule.
+///
+///        Protocol, one message per line (inputs take n + 1 lines in the input file format):
+///
+///            solve <id> [budget=<seconds>] [cores=<k>] [engine=<name>|portfolio] [seed=<s>]
+///                  [horizon=<minutes>] [progress=<seconds>]
+///            <input>
+///            stop <id>
+///            quit
+///
+///        Replies, where tasks are the 1-indexed sequence trimmed to the horizon:
+///
+///            accepted <id> cores=<k>
+///            best <id> <seconds> <profit> <numTasks> <tasks...>
+///            done <id> <seconds> <profit> <numTasks> <tasks...>
+///            error <id> <message>
+///
+///        Request ids are scoped to the client that sent them: a client can only stop its
+///        own requests, and different clients may use the same ids.
+///
+class SolveService
+{
+public:
+    typedef std::function<bool(std::string&)> LineReader;      // Reads one line, false at the end of the stream.
+    typedef std::function<void(const std::string&)> LineWriter; // Writes one line, called from many threads.
+
+    struct Request {
+        std::string id;
+        Input input;
+        bool usePortfolio = true;       // Portfolio of the size class of the input if true, engine otherwise.
+        Engine engine = SIMULATED_ANNEALING;
+        double timeBudget = 1.0;        // Wall-clock seconds.
+        int cores = 1;                  // Cores reserved for the request.
+        int seed = 0;
+        double progressPeriod = 0.1;    // Minimum seconds between two best-so-far replies.
+    };
+
+private:
+    int numCores;
+    Portfolio portfolio;
+    ThreadPool workers;                 // One request per worker, created once.
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    int freeCores;
+    long long nextTicket = 0;           // Cores are granted in ticket order.
+    long long servedTicket = 0;
+    long long nextClient = 0;           // Token of the next client of serve().
+    std::map<std::pair<long long, std::string>, std::shared_ptr<SolveControl>> running;    // By client and id.
+
+public:
+    SolveService(int numCores, const Portfolio& portfolio = Portfolio());
+
+    void serve(const LineReader& read, const LineWriter& write);
+    void submit(long long client, const Request& request, const LineWriter& write,
+                const std::function<void()>& finished);
+    bool stop(long long client, const std::string& id);
+
+    static bool parseRequest(const std::string& header, const LineReader& read, Request& request, std::string& error);
+    static std::string formatSchedule(const Input& input, const Output& output);
+
+private:
+    void solve(const Request& request, SolveControl& control, const LineWriter& write);
+    int acquireCores(int cores);
+    void releaseCores(int cores);
+};
+
+#endif // SOLVESERVICE_H
@@ -0,0 +1,287 @@
+#include "tabusolver.h"
+#include "greedysolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+TabuSolver::Move::Move() : type(-1), i(0), j(0), delta(-INFINITY) {}
+
+///
+/// \brief Compares two moves by profit gain, breaking ties by type and indices so
+///        that the chosen move does not depend on how the neighbourhood was split.
+/// \param other: Move to compare against.
+/// \return True if this move should be preferred over other.
+///
+bool TabuSolver::Move::betterThan(const Move &other) const {
+    if (type < 0) {
+        return false;
+    } else if (other.type < 0 || delta != other.delta) {
+        return other.type < 0 || delta > other.delta;
+    } else if (type != other.type) {
+        return type < other.type;
+    } else if (i != other.i) {
+        return i < other.i;
+    } else {
+        return j < other.j;
+    }
+}
+
+TabuSolver::TabuSolver() {}
+
+///
+/// \brief Initializes a solver instance using the Input.
+/// \param in: Problem is specified by this Input.
+/// \param s: Settings used by run().
+///
+TabuSolver::TabuSolver(const Input &in, const Settings &s) {
+    input = in;
+    settings = s;
+}
+
+///
+/// \brief Solves the problem with the seed and settings specified.
+/// \param seed: Seed for the random starting sequence, ignored if s.greedyStart is set.
+/// \param s: Settings for the solver.
+/// \return The best task sequence found by the algorithm
+///         specified by an untrimmed Output.
+///
+Output TabuSolver::solve(int seed, Settings s) {
+    ScheduleState state(input, initialSequence(seed, s));
+    if (s.verbose) {
+        std::cout << "---------------- TABU SEARCH SOLVE BEGIN ----------------\n";
+        std::cout << "seed == " << seed << '\n';
+        std::cout << "Printing Parameters... \n" << s;
+        std::cout << "Input size == " << input.size() << '\n';
+        std::cout << "Initial profit == " << state.getProfit() << '\n';
+    }
+    ThreadPool pool(NUM_THREADS);
+    Output best = search(state, s, pool);
+    if (s.verbose) {
+        std::cout << "Final profit == " << best.evaluate(input) << '\n';
+        std::cout << "---------------- TABU SEARCH SOLVE DONE ----------------\n";
+    }
+    return best;
+}
+
+///
+/// \brief Returns the name of the solver.
+/// \return Name of the solver.
+///
+std::string TabuSolver::name() const {
+    return "Tabu";
+}
+
+///
+/// \brief Repeats the search with the settings given at construction until the
+///        control asks to stop. Each repetition starts from the incumbent with a few
+///        random swaps applied, since the search itself is deterministic.
+/// \param seed: Seed for the starting sequence and the random swaps.
+/// \param numThreads: Number of threads scanning the neighbourhood.
+/// \param control: Deadline and incumbent shared with other solvers.
+/// \return The best task sequence found by this solver.
+///
+Output TabuSolver::run(int seed, int numThreads, SolveControl &control) {
+    ThreadPool pool(numThreads);
+    std::mt19937_64 gen(seed);
+    ScheduleState state(input, initialSequence(seed, settings));
+    Output best = state.toOutput();
+    double maxProfit = state.getProfit();
+    while (!control.shouldStop() && state.size() >= 2) {
+        Output result = search(state, settings, pool, &control);
+        double profit = result.evaluate(input);
+        if (profit > maxProfit) {
+            maxProfit = profit;
+            best = result;
+        }
+        control.offer(result, profit);
+
+        Output incumbent = best;
+        control.getIncumbent(incumbent, profit);
+        state.assign(incumbent.getSchedule());
+        for (int k = 0; k < KICK_SWAPS; ++k) {
+            int index1 = std::uniform_int_distribution<int>(0, std::min(state.cutoff(), state.size() - 1))(gen);
+            int index2 = std::uniform_int_distribution<int>(0, state.size() - 1)(gen);
+            state.applySwap(index1, index2);
+        }
+    }
+    return best;
+}
+
+///
+/// \brief Runs tabu search from the given state until the stopping criteria in the
+///        settings are met.
+/// \param state: Starting sequence, left at the last sequence visited.
+/// \param s: Settings for the solver.
+/// \param pool: Threads scanning the neighbourhood, one part per thread.
+/// \param control: If specified, the search stops early when the control asks to stop,
+///        and improvements are offered to it.
+/// \return The best task sequence visited, specified by an untrimmed Output.
+///
+Output TabuSolver::search(ScheduleState &state, const Settings &s, ThreadPool &pool, SolveControl *control) {
+    Output best = state.toOutput();
+    if (state.size() < 2) {
+        return best;
+    }
+    double bestProfit = state.getProfit();
+    tabuUntil.assign(static_cast<size_t>(1) << TABU_TABLE_BITS, -1);
+
+    int numWorkers = pool.size();
+    std::vector<Move> candidates(numWorkers);
+    int noImprove = 0;
+    int iteration = 0;
+    for (; iteration < s.maxIterations && noImprove < s.maxNoImprove; ++iteration) {
+        if (control && control->shouldStop()) {
+            break;
+        }
+        pool.parallelFor(numWorkers, [&](int worker) {
+            candidates[worker] = scanNeighbourhood(state, worker, numWorkers, iteration, bestProfit, s);
+        });
+        Move move;
+        for (const Move& candidate : candidates) {
+            if (candidate.betterThan(move)) {
+                move = candidate;
+            }
+        }
+        if (move.type < 0) {    // every move is tabu
+            break;
+        }
+
+        // Forbid the moved tasks from returning to the positions they leave.
+        makeTabu(state.taskAt(move.i), move.i, iteration, s.tenure);
+        if (move.type == SWAP) {
+            makeTabu(state.taskAt(move.j), move.j, iteration, s.tenure);
+            state.applySwap(move.i, move.j);
+        } else {
+            state.applyInsert(move.i, move.j);
+        }
+
+        if (state.getProfit() > bestProfit) {
+            if (state.getProfit() - bestProfit < PROFIT_GAIN_THRESH) {
+                ++noImprove;
+            } else {
+                noImprove = 0;
+            }
+            bestProfit = state.getProfit();
+            best = state.toOutput();
+            if (control) {
+                control->offer(best, bestProfit);
+            }
+        } else {
+            ++noImprove;
+        }
+        if (s.verbose && iteration % s.printPeriod == 0) {
+            std::cout << "Iteration " << iteration << ": current profit == " << state.getProfit()
+                      << ", best profit == " << bestProfit << '\n';
+        }
+    }
+    if (s.verbose) {
+        std::cout << "SEARCH STOPPED AFTER " << iteration << " ITERATIONS.\n";
+    }
+    return best;
+}
+
+///
+/// \brief Finds the best admissible move among the part of the neighbourhood assigned
+///        to a worker. Worker w scans the moves whose first index is congruent to w
+///        modulo the number of workers. Moves with both indices past the cutoff are skipped since
+///        they never change the profit.
+/// \param state: Current sequence.
+/// \param worker: Index of the worker.
+/// \param numWorkers: Number of workers scanning the neighbourhood.
+/// \param iteration: Current iteration, used to look up the tabu list.
+/// \param bestProfit: Best profit found so far, used for aspiration.
+/// \param s: Settings for the solver.
+/// \return Best admissible move, or a move with negative type if there is none.
+///
+TabuSolver::Move TabuSolver::scanNeighbourhood(const ScheduleState &state, int worker, int numWorkers,
+                                               int iteration, double bestProfit, const Settings &s) const {
+    int n = state.size();
+    int c = std::min(state.cutoff(), n - 1);
+    double aspiration = bestProfit + PROFIT_GAIN_THRESH - state.getProfit();
+    Move best;
+    Move move;
+
+    move.type = SWAP;
+    for (move.i = worker; move.i <= c; move.i += numWorkers) {
+        int a = state.taskAt(move.i);
+        for (move.j = move.i + 1; move.j < n; ++move.j) {
+            move.delta = state.swapDelta(move.i, move.j);
+            if (!move.betterThan(best)) {
+                continue;
+            }
+            bool tabu = isTabu(a, move.j, iteration) || isTabu(state.taskAt(move.j), move.i, iteration);
+            if (!tabu || move.delta > aspiration) {
+                best = move;
+            }
+        }
+    }
+    if (!s.useInsertions) {
+        return best;
+    }
+
+    move.type = INSERT;
+    for (move.i = worker; move.i < n; move.i += numWorkers) {
+        int x = state.taskAt(move.i);
+        int last = move.i <= c ? n - 1 : c;
+        for (move.j = 0; move.j <= last; ++move.j) {
+            if (move.j == move.i) {
+                continue;
+            }
+            move.delta = state.insertDelta(move.i, move.j);
+            if (move.betterThan(best) && (!isTabu(x, move.j, iteration) || move.delta > aspiration)) {
+                best = move;
+            }
+        }
+    }
+    return best;
+}
+
+///
+/// \brief Forbids a task from returning to a position for the next tenure iterations.
+/// \param task: 0-indexed task.
+/// \param position: Position the task is leaving.
+/// \param iteration: Current iteration.
+/// \param tenure: Number of iterations the pair stays tabu.
+///
+void TabuSolver::makeTabu(int task, int position, int iteration, int tenure) {
+    tabuUntil[tabuSlot(task, position)] = iteration + tenure;
+}
+
+///
+/// \brief Checks whether placing a task at a position is tabu. Distinct pairs may
+///        share a slot, which can only make the search more conservative.
+/// \param task: 0-indexed task.
+/// \param position: Position in the sequence.
+/// \param iteration: Current iteration.
+/// \return True if the move is tabu.
+///
+bool TabuSolver::isTabu(int task, int position, int iteration) const {
+    return tabuUntil[tabuSlot(task, position)] >= iteration;
+}
+
+///
+/// \brief Hashes a (task, position) pair to a slot in the tabu table.
+/// \param task: 0-indexed task.
+/// \param position: Position in the sequence.
+/// \return Index into tabuUntil.
+///
+size_t TabuSolver::tabuSlot(int task, int position) const {
+    uint64_t key = static_cast<uint64_t>(task) * 0x9E3779B97F4A7C15ULL
+                 ^ static_cast<uint64_t>(position) * 0xC2B2AE3D27D4EB4FULL;
+    return static_cast<size_t>(key >> (64 - TABU_TABLE_BITS));
+}
+
+///
+/// \brief Returns the sequence the search starts from.
+/// \param seed: Seed for the random sequence.
+/// \param s: Settings for the solver.
+/// \return Best greedy sequence if s.greedyStart is set, a random permutation otherwise.
+///
+Output TabuSolver::initialSequence(int seed, const Settings &s) const {
+    if (s.greedyStart) {
+        GreedySolver gs(input);
+        return gs.solve();
+    }
+    std::mt19937_64 gen(seed);
+    return randomSequence(input, gen);
+}
@@ -0,0 +1,98 @@
+#ifndef TABUSOLVER_H
+#define TABUSOLVER_H
+#include "input.h"
+#include "output.h"
+#include "schedulestate.h"
+#include "solver.h"
+#include "threadpool.h"
+#include <random>
+
+///
+/// \brief Tabu search solver. Every iteration scans the whole swap and insertion
+///        neighbourhood of the current sequence with incremental evaluation, split
+///        across NUM_THREADS workers, and applies the best admissible move even if it
+///        lowers the profit. A task is forbidden from returning to a position it
+///        recently left unless the move beats the best profit found so far (aspiration).
+///        Apart from the optional random starting sequence, the search is deterministic.
+///        solve() scans on NUM_THREADS threads, run() on the number of threads it is given.
+///
+class TabuSolver : public Solver
+{
+public:
+    static const int NUM_THREADS = 8;
+    struct Settings {
+        int maxIterations;      // Maximum number of moves applied.
+        int maxNoImprove;       // Stop after this many consecutive iterations without improving the best profit.
+        int tenure;             // Number of iterations a task may not return to a position it left.
+        bool useInsertions;     // Scan insertion moves in addition to swaps.
+        bool greedyStart;       // Start from the best greedy sequence instead of a random one.
+        bool verbose;           // Prints progress if set to true.
+        int printPeriod;        // Print a summary every this number of iterations.
+
+        Settings(int maxIterations = 100000,
+                 int maxNoImprove = 2000,
+                 int tenure = 20,
+                 bool useInsertions = true,
+                 bool greedyStart = true,
+                 bool verbose = false,
+                 int printPeriod = 100) {
+            this->maxIterations = maxIterations;
+            this->maxNoImprove = maxNoImprove;
+            this->tenure = tenure;
+            this->useInsertions = useInsertions;
+            this->greedyStart = greedyStart;
+            this->verbose = verbose;
+            this->printPeriod = printPeriod;
+        }
+
+        friend std::ostream& operator <<(std::ostream& out, const Settings& s) {
+            out << "GLOBAL NUM_THREADS == " << TabuSolver::NUM_THREADS << '\n';
+            out << "Max iterations == " << s.maxIterations << '\n';
+            out << "Max iterations with no profit gain == " << s.maxNoImprove << '\n';
+            out << "Tabu tenure == " << s.tenure << '\n';
+            out << "Use insertions == " << s.useInsertions << '\n';
+            out << "Greedy start == " << s.greedyStart << '\n';
+            return out;
+        }
+    };
+
+private:
+    enum MoveType { SWAP = 0, INSERT = 1 };
+    struct Move {
+        int type;
+        int i;
+        int j;
+        double delta;
+
+        Move();
+        bool betterThan(const Move& other) const;
+    };
+
+    Input input;
+    Settings settings;
+    const int TABU_TABLE_BITS = 16;             // Tabu list is a hash table with 2^TABU_TABLE_BITS entries.
+    const int KICK_SWAPS = 3;                   // Number of random swaps applied to the incumbent before run() searches again.
+    const double PROFIT_GAIN_THRESH = 1e-3;     // No profit is considered gained if less than this value.
+
+    std::vector<int> tabuUntil;                 // tabuUntil[hash(task, position)] == last iteration the pair is tabu.
+
+public:
+    TabuSolver();
+    TabuSolver(const Input& in, const Settings& s = Settings());
+
+    Output solve(int seed = 0, Settings s = Settings());
+
+    std::string name() const override;
+    Output run(int seed, int numThreads, SolveControl& control) override;
+
+private:
+    Output search(ScheduleState& state, const Settings& s, ThreadPool& pool, SolveControl* control = nullptr);
+    Move scanNeighbourhood(const ScheduleState& state, int worker, int numWorkers, int iteration,
+                           double bestProfit, const Settings& s) const;
+    void makeTabu(int task, int position, int iteration, int tenure);
+    bool isTabu(int task, int position, int iteration) const;
+    size_t tabuSlot(int task, int position) const;
+    Output initialSequence(int seed, const Settings& s) const;
+};
+
+#endif // TABUSOLVER_H
@@ -1,4 +1,6 @@
 #include "tests.h"
+#include <algorithm>
+#include <numeric>
 
 
 void testRandomInputGeneration() {
@@ -8,6 +10,20 @@ void testRandomInputGeneration() {
     }
 }
 
+void testInputValidation() {
+    const char* cases[][2] = {
+        {"valid", "3\n1 10 10 10\n2 20 5 30\n3 15 5 5\n"},
+        {"bad deadline in the middle", "3\n1 10 10 10\n2 -5000 5 30\n3 15 5 5\n"},
+        {"bad deadline last", "3\n1 10 10 10\n2 20 5 30\n3 -5000 5 5\n"},
+        {"truncated", "3\n1 10 10 10\n2 20 5 30\n3 15\n"},
+    };
+    for (const auto& c : cases) {
+        Input in = Input::fromText(c[1], c[0]);
+        std::cout << c[0] << ": failed == " << in.failed() << ", valid == " << in.isValid()
+                  << ", error == " << in.getError() << std::endl;
+    }
+}
+
 void testRandomInputNaiveSolve(int inputSize, int seed) {
     Input in(inputSize, seed);
     NaiveSolver ns(in);
@@ -43,3 +59,257 @@ void testSASolveRandomSmallInputs(int inputSize) {
     }
     std::cout << "Average delta == " << delta / 1000 << std::endl;
 }
+
+void testScheduleStateMoves(int inputSize, int seed) {
+    Input in(inputSize, seed);
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<int> indexDist(0, inputSize - 1);
+    ScheduleState state(in);
+    double maxError = 0;
+    for (int iter = 0; iter < 10000; ++iter) {
+        int i = indexDist(gen);
+        int j = indexDist(gen);
+        double expected;
+        if (iter % 2 == 0) {
+            expected = state.getProfit() + state.swapDelta(i, j);
+            state.applySwap(i, j);
+        } else {
+            expected = state.getProfit() + state.insertDelta(i, j);
+            state.applyInsert(i, j);
+        }
+        double actual = state.toOutput().evaluate(in);
+        maxError = std::max(maxError, std::max(std::abs(expected - actual), std::abs(state.getProfit() - actual)));
+    }
+    std::cout << "Max error between incremental and full evaluation == " << maxError << std::endl;
+}
+
+void testFixedPointDrift(int inputSize, int seed) {
+    Input in(inputSize, seed);
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<int> indexDist(0, inputSize - 1);
+    FixedScheduleState state(in);
+    int mismatches = 0;
+    double maxError = 0;
+    for (int iter = 0; iter < 100000; ++iter) {
+        int i = indexDist(gen);
+        int j = indexDist(gen);
+        if (iter % 2 == 0) {
+            state.applySwap(i, j);
+        } else {
+            state.applyInsert(i, j);
+        }
+        Output out = state.toOutput();
+        if (state.getValue() != out.evaluateFixed(in)) {
+            ++mismatches;
+        }
+        maxError = std::max(maxError, std::abs(state.getProfit() - out.evaluate(in)));
+    }
+    std::cout << "Incremental totals different from full evaluation == " << mismatches << std::endl;
+    std::cout << "Max error against floating-point evaluation == " << maxError << std::endl;
+}
+
+void testBatchEvaluator(int inputSize, int seed) {
+    Input in(inputSize, seed);
+    std::mt19937_64 gen(seed);
+    std::vector<Output> outs;
+    for (int k = 0; k < 61; ++k) {
+        std::vector<int> sequence(inputSize);
+        std::iota(sequence.begin(), sequence.end(), 0);
+        std::shuffle(sequence.begin(), sequence.end(), gen);
+        sequence.resize(gen() % (inputSize + 1));   // schedules of different lengths share a batch
+        outs.push_back(Output(sequence));
+    }
+    outs[0] = Output();
+    std::vector<std::pair<int, int>> swaps;
+    std::uniform_int_distribution<int> indexDist(0, inputSize - 1);
+    for (int k = 0; k < 61; ++k) {
+        swaps.push_back(std::make_pair(indexDist(gen), indexDist(gen)));
+    }
+    std::vector<int> all(inputSize);
+    std::iota(all.begin(), all.end(), 0);
+    Output base(all);
+    int mismatches = 0;
+    for (int isa = BatchEvaluator::SCALAR; isa <= BatchEvaluator::AVX512; ++isa) {
+        BatchEvaluator evaluator(in, static_cast<BatchEvaluator::Isa>(isa));
+        std::vector<double> profits;
+        evaluator.evaluate(outs, profits);
+        for (size_t k = 0; k < outs.size(); ++k) {
+            mismatches += profits[k] != outs[k].evaluate(in);
+        }
+        evaluator.evaluateSwaps(base, swaps, profits);
+        for (size_t k = 0; k < swaps.size(); ++k) {
+            Output swapped = base;
+            swapped.swapTasks(swaps[k].first, swaps[k].second);
+            mismatches += profits[k] != swapped.evaluate(in);
+        }
+        std::cout << BatchEvaluator::isaName(evaluator.getIsa()) << ": profits different from Output::evaluate == "
+                  << mismatches << std::endl;
+    }
+}
+
+template <class Policy>
+int compactScheduleMismatches(const Input& in, int seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<int> sequence(in.size());
+    std::iota(sequence.begin(), sequence.end(), 0);
+    int mismatches = 0;
+    for (int k = 0; k < 1000; ++k) {
+        std::shuffle(sequence.begin(), sequence.end(), gen);
+        mismatches += CompactSchedule<Policy>(in, Output(sequence)).evaluate() != Output(sequence).evaluate(in);
+    }
+    return mismatches;
+}
+
+void testCompactSchedule(int seed) {
+    for (int n : {60, 100, 137, 150, 173, 200}) {
+        Input in(n, seed);
+        int mismatches = compactScheduleMismatches<GenericPolicy<>>(in, seed);
+        mismatches += n <= 100 ? compactScheduleMismatches<PresetPolicy<100>>(in, seed)
+                    : n <= 150 ? compactScheduleMismatches<PresetPolicy<150>>(in, seed)
+                               : compactScheduleMismatches<PresetPolicy<200>>(in, seed);
+        mismatches += compactScheduleMismatches<PresetPolicy<200, MAX_TIME, uint16_t>>(in, seed);
+        std::cout << n << " tasks: profits different from Output::evaluate == " << mismatches << std::endl;
+    }
+}
+
+void testIncrementalResolve(int inputSize, int seed) {
+    Input oldIn(inputSize, seed);
+    SASolver sas(oldIn);
+    Output oldOut = sas.solve(seed, SASolver::Settings(0, 0.95, 10, 0.25, 0.8, false, 1, true));
+
+    // Remove two tasks, add two, and re-prioritize one.
+    Input extra(2, seed + 1);
+    std::vector<int> deadlines = oldIn.getDeadlines();
+    std::vector<int> durations = oldIn.getDurations();
+    std::vector<double> profits = oldIn.getProfits();
+    for (int k = 0; k < 2; ++k) {
+        deadlines.erase(deadlines.begin() + k * inputSize / 3);
+        durations.erase(durations.begin() + k * inputSize / 3);
+        profits.erase(profits.begin() + k * inputSize / 3);
+        deadlines.push_back(extra.getDeadline(k));
+        durations.push_back(extra.getDuration(k));
+        profits.push_back(extra.getProfit(k));
+    }
+    profits[inputSize / 2] = 99.999;
+    Input newIn(deadlines, durations, profits);
+
+    IncrementalSolver is(newIn);
+    std::vector<int> match = IncrementalSolver::matchTasks(oldIn, newIn);
+    Output repaired = is.repair(oldIn, oldOut);
+    Output resolved = is.solve(oldIn, oldOut, seed);
+    std::cout << "Matched tasks == " << std::count_if(match.begin(), match.end(), [](int m) { return m >= 0; })
+              << " of " << oldIn.size() << std::endl;
+    std::cout << "Old profit == " << oldOut.evaluate(oldIn) << ", repaired == " << repaired.evaluate(newIn)
+              << ", re-solved == " << resolved.evaluate(newIn) << std::endl;
+}
+
+void testLargeInstance(int inputSize, double timeBudget, int seed) {
+    Input in(inputSize, seed, inputSize * 15);
+    GreedySolver gs(in);
+    SASolver sas(in, SASolver::Settings(0, 0.95, 10, 1.0, 0.5, false, 1, true, "", 32));
+    SolveControl control(timeBudget);
+    Output out = sas.run(seed, 1, control);
+    std::cout << "Least overdue greedy profit == " << gs.solveLeastOverdue().evaluate(in) << std::endl;
+    std::cout << "Large-instance SA profit == " << out.evaluate(in) << " after " << control.elapsedSeconds()
+              << " seconds" << std::endl;
+}
+
+void testDynasearch(int inputSize, int seed) {
+    Input in(inputSize, seed);
+    std::mt19937_64 gen(seed);
+    std::vector<int> sequence(inputSize);
+    std::iota(sequence.begin(), sequence.end(), 0);
+    std::shuffle(sequence.begin(), sequence.end(), gen);
+    Dynasearch::Result result = Dynasearch(in).polish(Output(sequence));
+    LocalSearch::Result polished = LocalSearch(in).polish(Output(sequence));
+
+    // A local optimum of dynasearch admits no single improving swap or insertion.
+    FixedScheduleState state(in, result.output);
+    int improving = 0;
+    for (int i = 0; i <= std::min(state.cutoff(), inputSize - 1); ++i) {
+        for (int j = 0; j < inputSize; ++j) {
+            improving += i != j && (state.swapDelta(i, j) > 0 || state.insertDelta(i, j) > 0 || state.insertDelta(j, i) > 0);
+        }
+    }
+    std::cout << "Random sequence profit == " << Output(sequence).evaluate(in) << std::endl;
+    std::cout << "Dynasearch profit == " << result.profit << " after " << result.passes << " passes of "
+              << result.moves << " moves, improving single moves left == " << improving << std::endl;
+    std::cout << "Local search profit == " << polished.profit << " after " << polished.moves << " moves" << std::endl;
+}
+
+void testLNSReoptimize(int inputSize, int trials, int seed) {
+    Input in(inputSize, seed);
+    LNSSolver lns(in);
+    std::mt19937_64 gen(seed);
+    std::vector<int> sequence(inputSize);
+    std::iota(sequence.begin(), sequence.end(), 0);
+    int mismatches = 0;
+    int improved = 0;
+    for (int t = 0; t < trials; ++t) {
+        std::shuffle(sequence.begin(), sequence.end(), gen);
+        std::vector<int> completion(inputSize);
+        for (int p = 0, time = 0; p < inputSize; ++p) {
+            time += in.getDuration(sequence[p]);
+            completion[p] = time;
+        }
+        // Up to 7 positions drawn from a window of 15, so the fixed tasks between them shift too.
+        LNSSolver::Move move;
+        int first = std::uniform_int_distribution<int>(0, std::max(0, inputSize - 15))(gen);
+        for (int p = first; p < std::min(inputSize, first + 15) && move.positions.size() < 7; ++p) {
+            if (gen() % 2 || move.positions.size() < 2) {
+                move.positions.push_back(p);
+            }
+        }
+        FixedScheduleState::Value gain = lns.reoptimize(sequence, completion, move);
+
+        FixedScheduleState::Value current = FixedScheduleState(in, Output(sequence)).getValue();
+        FixedScheduleState::Value best = current;
+        std::vector<int> tasks;
+        for (int p : move.positions) {
+            tasks.push_back(sequence[p]);
+        }
+        std::sort(tasks.begin(), tasks.end());
+        do {
+            std::vector<int> permuted = sequence;
+            for (size_t r = 0; r < tasks.size(); ++r) {
+                permuted[move.positions[r]] = tasks[r];
+            }
+            best = std::max(best, FixedScheduleState(in, Output(permuted)).getValue());
+        } while (std::next_permutation(tasks.begin(), tasks.end()));
+        std::vector<int> applied = sequence;
+        for (size_t r = 0; r < move.tasks.size(); ++r) {
+            applied[move.positions[r]] = move.tasks[r];
+        }
+        mismatches += gain != best - current || FixedScheduleState(in, Output(applied)).getValue() - current != gain;
+        improved += gain > 0;
+    }
+    std::cout << "LNS groups improved == " << improved << " of " << trials
+              << ", mismatches with brute force == " << mismatches << std::endl;
+}
+
+void testVNSDescent(int inputSize, int seed) {
+    Input in(inputSize, seed);
+    std::mt19937_64 gen(seed);
+    std::vector<int> sequence(inputSize);
+    std::iota(sequence.begin(), sequence.end(), 0);
+    std::shuffle(sequence.begin(), sequence.end(), gen);
+    FixedScheduleState state(in, Output(sequence));
+    long long evaluations = 0;
+    int moves = VNSSolver(in).descend(state, 3, &evaluations);
+
+    // The descent ends at a local optimum of swaps, insertions, and block moves alike.
+    int improving = 0;
+    for (int i = 0; i <= std::min(state.cutoff(), inputSize - 1); ++i) {
+        for (int j = 0; j < inputSize; ++j) {
+            improving += i != j && (state.swapDelta(i, j) > 0 || state.insertDelta(i, j) > 0 || state.insertDelta(j, i) > 0);
+        }
+        for (int length = 2; length <= 3; ++length) {
+            for (int to = 0; to + length <= inputSize && i + length <= inputSize; ++to) {
+                improving += to != i && state.segmentDelta(i, length, to) > 0;
+            }
+        }
+    }
+    std::cout << "Random sequence profit == " << Output(sequence).evaluate(in) << std::endl;
+    std::cout << "VNS descent profit == " << state.getProfit() << " after " << moves << " moves and "
+              << evaluations << " evaluations, improving moves left == " << improving << std::endl;
+}
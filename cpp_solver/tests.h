@@ -1,11 +1,29 @@
 #ifndef TESTS_H
 #define TESTS_H
+#include "batcheval.h"
+#include "compactschedule.h"
+#include "dynasearch.h"
+#include "incrementalsolver.h"
+#include "lnssolver.h"
+#include "localsearch.h"
 #include "naivesolver.h"
 #include "sasolver.h"
 #include "greedysolver.h"
+#include "schedulestate.h"
+#include "vnssolver.h"
 
 void testRandomInputGeneration();
+void testInputValidation();
 void testRandomInputNaiveSolve(int inputSize, int seed = 0);
 void testSASolveRandomSmallInputs(int inputSize);
+void testScheduleStateMoves(int inputSize, int seed = 0);
+void testFixedPointDrift(int inputSize, int seed = 0);
+void testBatchEvaluator(int inputSize, int seed = 0);
+void testCompactSchedule(int seed = 0);
+void testIncrementalResolve(int inputSize, int seed = 0);
+void testLargeInstance(int inputSize, double timeBudget, int seed = 0);
+void testDynasearch(int inputSize, int seed = 0);
+void testLNSReoptimize(int inputSize, int trials, int seed = 0);
+void testVNSDescent(int inputSize, int seed = 0);
 
 #endif // TESTS_H
@@ -0,0 +1,207 @@
+#include "threadplacement.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+int readInt(const std::string& fileName, int fallback) {
+    std::ifstream fs(fileName);
+    int value;
+    return fs >> value ? value : fallback;
+}
+
+///
+/// \brief Parses a Linux CPU list such as "0-3,8-11".
+///
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        int first, last;
+        char dash;
+        std::stringstream rs(range);
+        if (!(rs >> first)) {
+            continue;
+        }
+        last = rs >> dash >> last ? last : first;
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+///
+/// \brief Reads the CPUs this process may run on and their topology from sysfs.
+///
+std::vector<ThreadPlacement::Cpu> detectTopology() {
+    std::vector<ThreadPlacement::Cpu> cpus;
+#ifdef __linux__
+    const std::string sysCpu = "/sys/devices/system/cpu/";
+    std::ifstream online(sysCpu + "online");
+    std::string list;
+    std::getline(online, list);
+
+    std::map<int, int> nodeOf;
+    for (int node = 0; node < 1024; ++node) {
+        std::ifstream fs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string nodeList;
+        if (!std::getline(fs, nodeList)) {
+            if (node > 0) {
+                break;
+            }
+            continue;
+        }
+        for (int cpu : parseCpuList(nodeList)) {
+            nodeOf[cpu] = node;
+        }
+    }
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool restricted = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    for (int id : parseCpuList(list)) {
+        if (restricted && !CPU_ISSET(id, &allowed)) {
+            continue;
+        }
+        std::string topology = sysCpu + "cpu" + std::to_string(id) + "/topology/";
+        ThreadPlacement::Cpu cpu = {id, readInt(topology + "physical_package_id", 0), readInt(topology + "core_id", id),
+                                    nodeOf.count(id) ? nodeOf[id] : 0};
+        cpus.push_back(cpu);
+    }
+#endif
+    return cpus;
+}
+
+} // namespace
+
+///
+/// \brief Orders the CPUs of the process for a placement policy.
+/// \param policy: Placement policy, NONE to leave threads unpinned.
+///
+ThreadPlacement::ThreadPlacement(Policy policy) : ThreadPlacement(policy, topology()) {}
+
+///
+/// \brief Orders CPUs for a placement policy.
+/// \param policy: Placement policy, NONE to leave threads unpinned.
+/// \param cpus: CPUs to place threads on, such as those returned by topology().
+///
+ThreadPlacement::ThreadPlacement(Policy policy, const std::vector<Cpu> &cpus) : policy(policy) {
+    if (policy == NONE || cpus.empty()) {
+        return;
+    }
+
+    // Hardware threads of every physical core, grouped by socket.
+    std::map<int, std::map<int, std::vector<int>>> sockets;
+    for (const Cpu& cpu : cpus) {
+        sockets[cpu.socket][cpu.core].push_back(cpu.id);
+    }
+    std::vector<std::vector<std::vector<int>>> cores;   // [socket][core in socket][sibling]
+    size_t maxCores = 0;
+    for (const std::pair<const int, std::map<int, std::vector<int>>>& socket : sockets) {
+        cores.emplace_back();
+        for (const std::pair<const int, std::vector<int>>& core : socket.second) {
+            cores.back().push_back(core.second);
+        }
+        maxCores = std::max(maxCores, cores.back().size());
+    }
+
+    if (policy == SMT_SIBLINGS) {
+        for (const std::vector<std::vector<int>>& socket : cores) {
+            for (const std::vector<int>& core : socket) {
+                order.insert(order.end(), core.begin(), core.end());
+            }
+        }
+        return;
+    }
+    for (size_t sibling = 0; order.size() < cpus.size(); ++sibling) {
+        for (size_t k = 0; k < maxCores; ++k) {
+            for (const std::vector<std::vector<int>>& socket : cores) {
+                if (k < socket.size() && sibling < socket[k].size()) {
+                    order.push_back(socket[k][sibling]);
+                }
+            }
+        }
+    }
+}
+
+///
+/// \brief Returns the placement policy.
+/// \return Placement policy.
+///
+ThreadPlacement::Policy ThreadPlacement::getPolicy() const {
+    return policy;
+}
+
+///
+/// \brief Returns the CPU of a solver thread. Threads beyond the number of CPUs wrap around.
+/// \param thread: Index of the thread, from 0.
+/// \return CPU id, -1 if the thread should not be pinned.
+///
+int ThreadPlacement::cpuFor(int thread) const {
+    return order.empty() ? -1 : order[thread % order.size()];
+}
+
+///
+/// \brief Pins the calling thread to a CPU.
+/// \param cpu: CPU id returned by cpuFor.
+/// \return False if the thread was not pinned.
+///
+bool ThreadPlacement::pinCurrentThread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+///
+/// \brief Describes the location of a CPU for logs.
+/// \param cpu: CPU id, -1 for an unpinned thread.
+/// \return "cpu <id> (socket <s>, core <c>, node <n>)", or "unpinned".
+///
+std::string ThreadPlacement::describe(int cpu) {
+    for (const Cpu& c : topology()) {
+        if (c.id == cpu) {
+            return "cpu " + std::to_string(c.id) + " (socket " + std::to_string(c.socket) + ", core " +
+                   std::to_string(c.core) + ", node " + std::to_string(c.node) + ")";
+        }
+    }
+    return cpu < 0 ? "unpinned" : "cpu " + std::to_string(cpu);
+}
+
+///
+/// \brief Returns the CPUs this process may run on, detected once.
+/// \return CPUs ordered by id, empty if the topology is unknown.
+///
+const std::vector<ThreadPlacement::Cpu> &ThreadPlacement::topology() {
+    static const std::vector<Cpu> cpus = detectTopology();
+    return cpus;
+}
+
+///
+/// \brief Returns the name of a placement policy, as printed in settings.
+/// \param policy: Placement policy.
+/// \return Name of the policy.
+///
+const char *ThreadPlacement::policyName(Policy policy) {
+    switch (policy) {
+    case PHYSICAL_CORES: return "physical-cores";
+    case SMT_SIBLINGS: return "smt-siblings";
+    default: return "none";
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef THREADPLACEMENT_H
+#define THREADPLACEMENT_H
+#include <string>
+#include <vector>
+
+///
+/// \brief Chooses the CPU each solver thread is pinned to, so that the operating system
+///        does not migrate threads between cores and sockets during long runs. A thread
+///        pins itself before copying the Input and allocating its buffers, so that with the
+///        default first-touch policy of Linux, its memory is allocated on the NUMA node of
+///        its CPU.
+///
+///        PHYSICAL_CORES places one thread per physical core, alternating between sockets,
+///        and uses SMT siblings only once every core has a thread. SMT_SIBLINGS fills both
+///        hardware threads of a core before moving to the next one, so that pairs of threads
+///        share their caches. Pinning is only supported on Linux; elsewhere, and with NONE,
+///        threads are not pinned.
+///
+class ThreadPlacement
+{
+public:
+    enum Policy { NONE, PHYSICAL_CORES, SMT_SIBLINGS };
+
+    struct Cpu {
+        int id;
+        int socket;
+        int core;           // Physical core id within the socket.
+        int node;           // NUMA node, 0 if unknown.
+    };
+
+private:
+    Policy policy;
+    std::vector<int> order;     // CPUs in the order threads are placed on them.
+
+public:
+    ThreadPlacement(Policy policy = NONE);
+    ThreadPlacement(Policy policy, const std::vector<Cpu>& cpus);
+
+    Policy getPolicy() const;
+    int cpuFor(int thread) const;
+
+    static bool pinCurrentThread(int cpu);
+    static std::string describe(int cpu);
+    static const std::vector<Cpu>& topology();
+    static const char* policyName(Policy policy);
+};
+
+#endif // THREADPLACEMENT_H
@@ -0,0 +1,90 @@
+#include "threadpool.h"
+
+///
+/// \brief Starts the worker threads.
+/// \param numThreads: Number of worker threads, at least one is always created.
+///
+ThreadPool::ThreadPool(int numThreads) {
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    for (int tid = 0; tid < numThreads; ++tid) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+///
+/// \brief Finishes all queued tasks and joins the worker threads.
+///
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (std::thread& t : workers) {
+        t.join();
+    }
+}
+
+///
+/// \brief Returns the number of worker threads.
+/// \return Number of worker threads.
+///
+int ThreadPool::size() const {
+    return static_cast<int>(workers.size());
+}
+
+///
+/// \brief Queues a task to be run by the next idle worker.
+/// \param task: Task to run.
+///
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+///
+/// \brief Calls body(0), ..., body(count - 1) on the workers and blocks until
+///        all calls have returned.
+/// \param count: Number of calls.
+/// \param body: Function to call with each index.
+///
+void ThreadPool::parallelFor(int count, const std::function<void(int)> &body) {
+    std::mutex doneMutex;
+    std::condition_variable doneCond;
+    int remaining = count;
+    for (int i = 0; i < count; ++i) {
+        submit([&, i] {
+            body(i);
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (--remaining == 0) {
+                doneCond.notify_one();
+            }
+        });
+    }
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCond.wait(lock, [&] { return remaining == 0; });
+}
+
+///
+/// \brief Runs queued tasks until the pool is destroyed.
+///
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///
+/// \brief A fixed set of worker threads that are created once and reused, so that
+///        solvers which need to split work across cores many times per second do
+///        not pay for thread creation on every step.
+/// \note parallelFor must not be called from inside a task running on the same pool.
+///
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    bool stopping = false;
+
+public:
+    ThreadPool(int numThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator =(const ThreadPool&) = delete;
+
+    int size() const;
+    void submit(std::function<void()> task);
+    void parallelFor(int count, const std::function<void(int)>& body);
+
+private:
+    void workerLoop();
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,98 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../input.h"
+#include "../output.h"
+#include "../packedcorpus.h"
+
+using namespace std;
+
+// Build inside cpp_solver with:
+//     g++ -O2 -pthread -o packcorpus tools/packcorpus.cpp $(ls *.cpp | grep -v main.cpp)
+/* Usage: ./packcorpus pack <packFile> [--outputs]
+ *        ./packcorpus unpack <packFile> <inputDir> [<outputDir>]
+ *        ./packcorpus verify <packFile>
+ *
+ * pack: packs every instance of ../inputs/{small,medium,large}/, and with --outputs
+ *       also its output from ../outputs/, into packFile.
+ * unpack: writes the instances back as text files <inputDir>/<class>/<name>.in, and
+ *         their outputs, if packed, as <outputDir>/<class>/<name>.out.
+ * verify: checks the content hash and prints the number of instances.
+ */
+
+const string INPUT_DIR = "../inputs/";
+const string OUTPUT_DIR = "../outputs/";
+const string CLASS_NAMES[] = {"small", "medium", "large"};
+const int INSTANCES_PER_CLASS = 300;
+
+int pack(const string& packFile, bool withOutputs) {
+    vector<PackedCorpus::Entry> entries;
+    for (const string& className : CLASS_NAMES) {
+        for (int i = 1; i <= INSTANCES_PER_CLASS; ++i) {
+            PackedCorpus::Entry entry;
+            entry.name = className + '-' + to_string(i);
+            entry.input = Input(INPUT_DIR + className + '/' + entry.name + ".in");
+            if (entry.input.failed()) {
+                continue;
+            }
+            if (withOutputs) {
+                string error;
+                entry.output = Output(OUTPUT_DIR + className + '/' + entry.name + ".out", &error);
+                if (!error.empty() || !entry.output.isValidFor(entry.input)) {
+                    cerr << "Skipping output of " << entry.name << ' ' << error << '\n';
+                    entry.output = Output();
+                }
+            }
+            entries.push_back(entry);
+        }
+    }
+    if (!PackedCorpus::write(packFile, entries)) {
+        cerr << "Cannot write " << packFile << '\n';
+        return 1;
+    }
+    cout << "Packed " << entries.size() << " instances into " << packFile << '\n';
+    return 0;
+}
+
+int unpack(const PackedCorpus& corpus, const string& inputDir, const string& outputDir) {
+    for (int k = 0; k < corpus.size(); ++k) {
+        string name = corpus.name(k);
+        string className = name.substr(0, name.find('-'));
+        corpus.input(k).writeFile(inputDir + '/' + className + '/' + name + ".in");
+        if (!outputDir.empty() && corpus.outputLength(k) > 0) {
+            corpus.output(k).writeFile(outputDir + '/' + className + '/' + name + ".out");
+        }
+    }
+    cout << "Unpacked " << corpus.size() << " instances\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Usage: packcorpus pack|unpack|verify <packFile> ...\n";
+        return 2;
+    }
+    string command = argv[1];
+    string packFile = argv[2];
+    if (command == "pack") {
+        return pack(packFile, argc > 3 && strcmp(argv[3], "--outputs") == 0);
+    }
+    PackedCorpus corpus(packFile);
+    if (!corpus.isOpen()) {
+        cerr << corpus.getError() << '\n';
+        return 1;
+    }
+    if (command == "unpack" && argc > 3) {
+        return unpack(corpus, argv[3], argc > 4 ? argv[4] : "");
+    } else if (command == "verify") {
+        if (!corpus.verify()) {
+            cerr << packFile << ": content does not match its hash\n";
+            return 1;
+        }
+        cout << packFile << ": " << corpus.size() << " instances, hash OK\n";
+        return 0;
+    }
+    cerr << "Unknown command " << command << '\n';
+    return 2;
+}
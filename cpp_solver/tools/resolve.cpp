@@ -0,0 +1,57 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "../incrementalsolver.h"
+#include "../input.h"
+#include "../output.h"
+
+using namespace std;
+
+// Build inside cpp_solver with:
+//     g++ -O2 -pthread -o resolve tools/resolve.cpp $(ls *.cpp | grep -v main.cpp)
+/* Usage: ./resolve <oldInput> <oldOutput> <newInput> <newOutput> [seed]
+ *
+ * Solves newInput starting from oldOutput, the best known output of oldInput, instead of
+ * from scratch (see incrementalsolver.h), and writes the trimmed result to newOutput.
+ * Meant for inputs that differ by a few added, removed, or re-prioritized tasks.
+ */
+
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        cerr << "Usage: " << argv[0] << " <oldInput> <oldOutput> <newInput> <newOutput> [seed]\n";
+        return 2;
+    }
+    Input oldInput(argv[1]);
+    string error;
+    Output oldOutput(argv[2], &error);
+    Input newInput(argv[3]);
+    if (oldInput.failed() || newInput.failed()) {
+        cerr << (oldInput.failed() ? oldInput.getError() : newInput.getError()) << '\n';
+        return 1;
+    } else if (!error.empty()) {
+        cerr << error << '\n';
+        return 1;
+    }
+    int seed = argc > 5 ? atoi(argv[5]) : 0;
+
+    auto start = chrono::steady_clock::now();
+    IncrementalSolver is(newInput);
+    vector<int> match = IncrementalSolver::matchTasks(oldInput, newInput);
+    int matched = 0;
+    for (int m : match) {
+        matched += m >= 0;
+    }
+    double repairedProfit = is.repair(oldInput, oldOutput).evaluate(newInput);
+    Output out = is.solve(oldInput, oldOutput, seed);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << matched << " of " << oldInput.size() << " tasks matched, "
+         << newInput.size() - matched << " added\n";
+    cout << "Old profit == " << oldOutput.evaluate(oldInput) << '\n';
+    cout << "Repaired profit == " << repairedProfit << '\n';
+    cout << "Re-solved profit == " << out.evaluate(newInput) << " in " << seconds << " seconds\n";
+    out.trim(newInput);
+    out.writeFile(argv[4]);
+    return 0;
+}
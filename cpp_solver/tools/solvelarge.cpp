@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "../input.h"
+#include "../output.h"
+#include "../sasolver.h"
+
+using namespace std;
+
+// Build inside cpp_solver with:
+//     g++ -O2 -pthread -o solvelarge tools/solvelarge.cpp $(ls *.cpp | grep -v main.cpp)
+/* Usage: ./solvelarge (<inputFile> | --generate numTasks) [--horizon minutes] [--out outputFile]
+ *                     [--budget seconds] [--threads numThreads] [--window moveWindow] [--seed seed]
+ *
+ * Solves an instance of any size and horizon with SASolver in large-instance mode: every
+ * thread starts from the best O(n log n) greedy sequence and anneals with windowed swaps
+ * (see SASolver::solveInstanceFixed), restarting until the time budget runs out. With
+ * --generate, a random instance with numTasks tasks is solved instead of inputFile, with
+ * deadlines up to the horizon. The horizon defaults to MAX_TIME.
+ */
+
+int main(int argc, char* argv[]) {
+    string inputFile;
+    string outputFile;
+    int generate = 0;
+    int horizon = MAX_TIME;
+    double budget = 60.0;
+    int threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+    int window = 32;
+    int seed = 0;
+    for (int k = 1; k < argc; ++k) {
+        string flag = argv[k];
+        if (flag.compare(0, 2, "--") != 0) {
+            inputFile = flag;
+            continue;
+        } else if (k + 1 >= argc) {
+            cerr << "Missing value of " << flag << '\n';
+            return 2;
+        }
+        string value = argv[++k];
+        if (flag == "--generate") {
+            generate = atoi(value.c_str());
+        } else if (flag == "--horizon") {
+            horizon = atoi(value.c_str());
+        } else if (flag == "--out") {
+            outputFile = value;
+        } else if (flag == "--budget") {
+            budget = atof(value.c_str());
+        } else if (flag == "--threads") {
+            threads = max(1, atoi(value.c_str()));
+        } else if (flag == "--window") {
+            window = max(1, atoi(value.c_str()));
+        } else if (flag == "--seed") {
+            seed = atoi(value.c_str());
+        } else {
+            cerr << "Unknown option " << flag << '\n';
+            return 2;
+        }
+    }
+    if (inputFile.empty() == (generate <= 0)) {
+        cerr << "Specify either an input file or --generate numTasks\n";
+        return 2;
+    }
+
+    auto start = chrono::steady_clock::now();
+    Input in = generate > 0 ? Input(generate, seed, horizon) : Input(inputFile, 0, horizon);
+    if (in.failed()) {
+        cerr << in.getError() << '\n';
+        return 1;
+    }
+    cout << in.size() << " tasks, horizon == " << in.getHorizon() << ", read in "
+         << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " seconds" << endl;
+
+    SASolver::Settings settings(0, 0.95, 10, 1.0, 0.5, false, 1, true, "", window);
+    SASolver sas(in, settings);
+    SolveControl control(budget);
+    Output out = sas.run(seed, threads, control);
+    double profit = out.evaluate(in);
+    control.offer(out, profit);
+    vector<pair<double, double>> timeline = control.getTimeline();
+    cout << "Greedy start profit == " << (timeline.empty() ? 0.0 : timeline.front().second) << '\n';
+    cout << "Final profit == " << profit << " after " << control.elapsedSeconds() << " seconds on "
+         << threads << " threads" << endl;
+    if (!outputFile.empty()) {
+        out.trim(in);
+        out.writeFile(outputFile);
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "../solveservice.h"
+#ifndef _WIN32
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Build inside cpp_solver with:
+//     g++ -O2 -pthread -o solveserver tools/solveserver.cpp $(ls *.cpp | grep -v main.cpp)
+/* Usage: ./solveserver [--cores <k>] [--socket <path>]
+ *
+ * Runs a SolveService (see solveservice.h for the protocol) until it is killed or, without
+ * --socket, until the end of the standard input. Without --socket, requests are read from
+ * the standard input and replies written to the standard output. With --socket, every
+ * client connecting to the Unix socket at path is served on its own thread, and all
+ * clients share the cores of the service (all cores by default).
+ */
+
+///
+/// \brief Strips the carriage return of lines sent with Windows line endings.
+///
+void stripCarriageReturn(string& line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+}
+
+#ifndef _WIN32
+///
+/// \brief Reads lines from a socket through a buffer.
+///
+struct SocketLineReader {
+    int fd;
+    string buffer;
+
+    bool operator()(string& line) {
+        while (true) {
+            size_t newline = buffer.find('\n');
+            if (newline != string::npos) {
+                line = buffer.substr(0, newline);
+                buffer.erase(0, newline + 1);
+                stripCarriageReturn(line);
+                return true;
+            }
+            char chunk[4096];
+            ssize_t got = ::read(fd, chunk, sizeof(chunk));
+            if (got <= 0) {
+                if (buffer.empty()) {
+                    return false;
+                }
+                line.swap(buffer);
+                buffer.clear();
+                stripCarriageReturn(line);
+                return true;
+            }
+            buffer.append(chunk, got);
+        }
+    }
+};
+
+///
+/// \brief Accepts clients on a Unix socket forever.
+/// \return Nonzero if the socket cannot be created.
+///
+int serveSocket(SolveService& service, const string& path) {
+    signal(SIGPIPE, SIG_IGN);   // clients that disconnect early must not kill the server
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (listener < 0 || path.size() >= sizeof(address.sun_path)) {
+        cerr << path << ": cannot create socket\n";
+        return 1;
+    }
+    strcpy(address.sun_path, path.c_str());
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listener, 64) < 0) {
+        cerr << path << ": " << strerror(errno) << '\n';
+        return 1;
+    }
+    cerr << "Listening on " << path << '\n';
+    while (true) {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        thread([&service, client] {
+            mutex writeMutex;
+            SocketLineReader reader = {client, string()};
+            service.serve(reader, [&](const string& line) {
+                lock_guard<mutex> lock(writeMutex);
+                string message = line + '\n';
+                for (size_t sent = 0; sent < message.size(); ) {
+                    ssize_t n = ::write(client, message.data() + sent, message.size() - sent);
+                    if (n <= 0) {
+                        break;
+                    }
+                    sent += n;
+                }
+            });
+            close(client);
+        }).detach();
+    }
+}
+#endif
+
+int main(int argc, char* argv[]) {
+    int cores = max(1, static_cast<int>(thread::hardware_concurrency()));
+    string socketPath;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--cores" && i + 1 < argc) {
+            cores = atoi(argv[++i]);
+        } else if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else {
+            cerr << "Usage: " << argv[0] << " [--cores <k>] [--socket <path>]\n";
+            return 2;
+        }
+    }
+    SolveService service(cores);
+    if (!socketPath.empty()) {
+#ifndef _WIN32
+        return serveSocket(service, socketPath);
+#else
+        cerr << "Unix sockets are not supported on this platform, serving the standard input\n";
+#endif
+    }
+    mutex writeMutex;
+    service.serve([](string& line) {
+        if (!getline(cin, line)) {
+            return false;
+        }
+        stripCarriageReturn(line);
+        return true;
+    }, [&](const string& line) {
+        lock_guard<mutex> lock(writeMutex);
+        cout << line << endl;
+    });
+    return 0;
+}
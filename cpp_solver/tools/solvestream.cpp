@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "../bulkpipeline.h"
+
+using namespace std;
+
+// Build inside cpp_solver with:
+//     g++ -O2 -pthread -o solvestream tools/solvestream.cpp $(ls *.cpp | grep -v main.cpp)
+/* Usage: ./solvestream [options] [input]
+ *
+ * Solves a stream of instances from input (the standard input if omitted or "-") with
+ * a BulkPipeline (see bulkpipeline.h) and writes the results to the standard output.
+ *
+ *   --in in|jsonl             Concatenated input files (default), each ending with a line
+ *                             break as `awk 1 a.in b.in` writes them, or JSON lines
+ *                             mapping names to input file contents.
+ *   --out jsonl|json          JSON lines (default) or one object like submission.json.
+ *   --order arrival|completion
+ *                             Write results in input order (default) or as they complete.
+ *   --engine <name>|portfolio Engine of every instance (default SA).
+ *   --budget <seconds>        Time budget of every instance (default 1).
+ *   --cores <k>               Cores of every instance (default 1).
+ *   --workers <k>             Instances solved at the same time (default: all cores / cores).
+ *   --capacity <k>            Records between reading and writing (default 4 * workers).
+ *   --seed <s>                Seed of the first instance, the k-th uses seed + k - 1.
+ *
+ * For example, to solve all inputs into the format of submission.json:
+ *   python3 -c 'import json, os; [print(json.dumps({f: open(os.path.join(d, f)).read()}))
+ *                for d, _, fs in sorted(os.walk("../inputs")) for f in sorted(fs) if f.endswith(".in")]' \
+ *       | ./solvestream --in jsonl --out json --budget 5 > submission.json
+ */
+
+int main(int argc, char* argv[]) {
+    BulkPipeline::Settings s;
+    int numCores = max(1, static_cast<int>(thread::hardware_concurrency()));
+    s.numWorkers = 0;
+    s.capacity = 0;
+    string inputFile = "-";
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        string value = i + 1 < argc ? argv[i + 1] : "";
+        bool valid = true;
+        if (arg == "--in" && (value == "in" || value == "jsonl")) {
+            s.inputFormat = value == "in" ? BulkPipeline::IN : BulkPipeline::JSONL_INPUT;
+        } else if (arg == "--out" && (value == "jsonl" || value == "json")) {
+            s.outputFormat = value == "json" ? BulkPipeline::JSON : BulkPipeline::JSONL_OUTPUT;
+        } else if (arg == "--order" && (value == "arrival" || value == "completion")) {
+            s.arrivalOrder = value == "arrival";
+        } else if (arg == "--engine" && value == "portfolio") {
+            s.usePortfolio = true;
+        } else if (arg == "--engine" && engineFromName(value, s.engine)) {
+            s.usePortfolio = false;
+        } else if (arg == "--budget" && atof(value.c_str()) > 0) {
+            s.timeBudget = atof(value.c_str());
+        } else if (arg == "--cores" && atoi(value.c_str()) > 0) {
+            s.coresPerInstance = atoi(value.c_str());
+        } else if (arg == "--workers" && atoi(value.c_str()) > 0) {
+            s.numWorkers = atoi(value.c_str());
+        } else if (arg == "--capacity" && atoi(value.c_str()) > 0) {
+            s.capacity = atoi(value.c_str());
+        } else if (arg == "--seed" && !value.empty()) {
+            s.seed = atoi(value.c_str());
+        } else if (i == argc - 1 && (arg == "-" || arg[0] != '-')) {
+            inputFile = arg;
+            continue;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            cerr << "Invalid argument " << arg << ", see the top of tools/solvestream.cpp for usage\n";
+            return 2;
+        }
+        ++i;
+    }
+    if (s.numWorkers == 0) {
+        s.numWorkers = max(1, numCores / s.coresPerInstance);
+    }
+    if (s.capacity == 0) {
+        s.capacity = 4 * s.numWorkers;
+    }
+
+    ifstream file;
+    if (inputFile != "-") {
+        file.open(inputFile);
+        if (!file) {
+            cerr << inputFile << ": cannot open file\n";
+            return 1;
+        }
+    }
+    auto start = chrono::steady_clock::now();
+    BulkPipeline pipeline(s);
+    BulkPipeline::Summary summary = pipeline.run(inputFile == "-" ? cin : file, cout, cerr);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cerr << s << "Solved == " << summary.solved << ", failed == " << summary.failed
+         << ", total profit == " << summary.totalProfit << ", seconds == " << seconds << '\n';
+    return summary.failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,121 @@
+#include "trace.h"
+#include <chrono>
+#include <iostream>
+
+const int TraceWriter::DRAIN_PERIOD_MS;
+
+TraceBuffer::TraceBuffer() : head(0), tail(0), dropped(0) {}
+
+///
+/// \brief Removes the oldest event. Must only be called by the consumer thread.
+/// \param event: Assigned the oldest event if there is one.
+/// \return False if the ring was empty.
+///
+bool TraceBuffer::pop(TraceEvent &event) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+        return false;
+    }
+    event = events[t & (CAPACITY - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+///
+/// \brief Returns the number of events dropped because the ring was full.
+/// \return Number of dropped events.
+///
+size_t TraceBuffer::getDropped() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+///
+/// \brief Opens the output and starts the background thread.
+/// \param fileName: Directory to the trace file. Overwrites if file already exists.
+///        Events are written to std::cout if empty.
+/// \param numThreads: Number of producer threads, each gets its own buffer.
+///
+TraceWriter::TraceWriter(const std::string &fileName, int numThreads) : out(&std::cout) {
+    for (int tid = 0; tid < numThreads; ++tid) {
+        buffers.emplace_back(new TraceBuffer());
+    }
+    if (!fileName.empty()) {
+        file.open(fileName, std::ofstream::out);
+        out = &file;
+    }
+    *out << "seconds,thread,event,epoch,temperature,profit,acceptanceRate,rejections\n";
+    drainer = std::thread(&TraceWriter::drainLoop, this);
+}
+
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+///
+/// \brief Returns the buffer that thread tid should push its events to.
+/// \param tid: Index of the producer thread.
+/// \return Buffer owned by this writer.
+///
+TraceBuffer *TraceWriter::buffer(int tid) {
+    return buffers[tid].get();
+}
+
+///
+/// \brief Stops the background thread and writes every remaining event. The producers
+///        must have stopped pushing. Calling close more than once has no effect.
+///
+void TraceWriter::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return;
+        }
+        stopping = true;
+    }
+    stopRequested.notify_all();
+    drainer.join();
+    drain();
+    size_t dropped = 0;
+    for (const std::unique_ptr<TraceBuffer>& b : buffers) {
+        dropped += b->getDropped();
+    }
+    if (dropped > 0) {
+        *out << "# " << dropped << " events dropped\n";
+    }
+    out->flush();
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+///
+/// \brief Body of the background thread, drains the buffers periodically until close is called.
+///
+void TraceWriter::drainLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        stopRequested.wait_for(lock, std::chrono::milliseconds(DRAIN_PERIOD_MS));
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+///
+/// \brief Writes every event currently in the buffers.
+///
+void TraceWriter::drain() {
+    static const char* const KIND_NAMES[] = {"begin", "epoch", "frozen"};
+    TraceEvent e;
+    bool wrote = false;
+    for (size_t tid = 0; tid < buffers.size(); ++tid) {
+        while (buffers[tid]->pop(e)) {
+            *out << e.seconds << ',' << tid << ',' << KIND_NAMES[e.kind] << ',' << e.epoch << ','
+                 << e.temperature << ',' << e.profit << ',' << e.acceptanceRate << ',' << e.rejectionCount << '\n';
+            wrote = true;
+        }
+    }
+    if (wrote) {
+        out->flush();
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef TRACE_H
+#define TRACE_H
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+///
+/// \brief A structured progress event of a solver thread.
+///
+struct TraceEvent {
+    enum Kind { BEGIN, EPOCH, FROZEN };
+
+    Kind kind;
+    int epoch;
+    double seconds;         // Seconds since the solve started.
+    double temperature;
+    double profit;          // Current profit at the end of the epoch.
+    double acceptanceRate;  // Fraction of the perturbations of the epoch that were accepted.
+    int rejectionCount;     // Consecutive epochs without profit gain.
+};
+
+///
+/// \brief A fixed-capacity ring of TraceEvents with exactly one producer and one
+///        consumer thread. Neither side ever blocks or locks: push drops the event
+///        and counts it if the ring is full, so a slow consumer cannot slow the solver.
+///
+class TraceBuffer
+{
+public:
+    static const int CAPACITY_BITS = 12;
+    static const size_t CAPACITY = size_t(1) << CAPACITY_BITS;
+
+private:
+    static const size_t CACHE_LINE = 64;
+
+    TraceEvent events[CAPACITY];
+    std::atomic<size_t> head;       // Next slot to write, only modified by the producer.
+    char headPadding[CACHE_LINE];   // Keeps head and tail on separate cache lines.
+    std::atomic<size_t> tail;       // Next slot to read, only modified by the consumer.
+    char tailPadding[CACHE_LINE];
+    std::atomic<size_t> dropped;
+
+public:
+    TraceBuffer();
+
+    TraceBuffer(const TraceBuffer&) = delete;
+    TraceBuffer& operator =(const TraceBuffer&) = delete;
+
+    ///
+    /// \brief Appends an event. Must only be called by the producer thread.
+    /// \param event: Event to append.
+    /// \return False if the ring was full and the event was dropped.
+    ///
+    bool push(const TraceEvent& event) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        events[h & (CAPACITY - 1)] = event;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(TraceEvent& event);
+    size_t getDropped() const;
+};
+
+///
+/// \brief Owns one TraceBuffer per solver thread and a background thread that drains
+///        them to a file, or to std::cout if no file name is given. Solver threads only
+///        ever touch their own buffer, so tracing does not serialize them the way
+///        printing to a shared stream does. Each line of the output is
+///        "seconds,thread,event,epoch,temperature,profit,acceptanceRate,rejections".
+///
+class TraceWriter
+{
+private:
+    static const int DRAIN_PERIOD_MS = 20;
+
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    std::ofstream file;
+    std::ostream* out;
+    std::thread drainer;
+    std::mutex mutex;
+    std::condition_variable stopRequested;
+    bool stopping = false;
+
+public:
+    TraceWriter(const std::string& fileName, int numThreads);
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator =(const TraceWriter&) = delete;
+
+    TraceBuffer* buffer(int tid);
+    void close();
+
+private:
+    void drainLoop();
+    void drain();
+};
+
+#endif // TRACE_H
@@ -0,0 +1,273 @@
+#include "vnssolver.h"
+#include <algorithm>
+#include <thread>
+
+VNSSolver::VNSSolver() {}
+
+///
+/// \brief Initializes a solver instance using the Input.
+/// \param in: Problem is specified by this Input.
+/// \param s: Settings used by run().
+///
+VNSSolver::VNSSolver(const Input &in, const Settings &s) {
+    input = in;
+    settings = s;
+}
+
+///
+/// \brief Solves the problem with the seed and settings specified.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param s: Settings for the solver.
+/// \return The best task sequence found by the algorithm
+///         specified by an untrimmed Output.
+///
+Output VNSSolver::solve(int seed, Settings s) {
+    if (s.verbose) {
+        std::cout << "seed == " << seed << '\n';
+    }
+    std::vector<std::mt19937_64> gens(NUM_THREADS);
+    std::vector<std::thread> threads;
+    std::vector<Output> bestSequences(NUM_THREADS);
+    for (int tid = 0; tid < NUM_THREADS; ++tid) {
+        gens[tid].seed(seed + tid);
+        threads.emplace_back(std::thread(&VNSSolver::solveThread,
+                                         *this,
+                                         std::ref(bestSequences[tid]),
+                                         std::ref(gens[tid]),
+                                         s));
+    }
+    for (int tid = 0; tid < NUM_THREADS; ++tid) {
+        threads[tid].join();
+    }
+    return bestSequence(input, bestSequences);
+}
+
+///
+/// \brief Returns the name of the solver.
+/// \return Name of the solver.
+///
+std::string VNSSolver::name() const {
+    return "VNS";
+}
+
+///
+/// \brief Searches on numThreads threads with the settings given at construction,
+///        restarting until the control asks to stop.
+/// \param seed: Seed for pseudo-random number generator.
+/// \param numThreads: Number of threads to search on.
+/// \param control: Deadline and incumbent shared with other solvers.
+/// \return The best task sequence found by this solver.
+///
+Output VNSSolver::run(int seed, int numThreads, SolveControl &control) {
+    std::vector<std::mt19937_64> gens(numThreads);
+    std::vector<std::thread> threads;
+    std::vector<Output> bestSequences(numThreads);
+    for (int tid = 0; tid < numThreads; ++tid) {
+        gens[tid].seed(seed + tid);
+        threads.emplace_back(std::thread(&VNSSolver::runThread,
+                                         *this,
+                                         std::ref(bestSequences[tid]),
+                                         std::ref(gens[tid]),
+                                         std::ref(control)));
+    }
+    for (int tid = 0; tid < numThreads; ++tid) {
+        threads[tid].join();
+    }
+    return bestSequence(input, bestSequences);
+}
+
+///
+/// \brief Applies variable neighbourhood descent until no swap, insertion, or block
+///        move improves the profit. The best move of the current neighbourhood is applied
+///        if it improves, and the descent goes back to swaps; otherwise it moves on to
+///        the next, larger neighbourhood.
+/// \param state: Sequence to improve, for the Input of this solver.
+/// \param maxBlock: Block moves shift blocks of 2 to maxBlock tasks.
+/// \param evaluations: If specified, the number of moves evaluated is added to it.
+/// \return Number of moves applied.
+///
+int VNSSolver::descend(FixedScheduleState &state, int maxBlock, long long *evaluations) const {
+    long long evaluated = 0;
+    int moves = 0;
+    for (int k = SWAP; k < NUM_NEIGHBOURHOODS; ) {
+        LocalSearch::Move move = bestMove(state, static_cast<Neighbourhood>(k), maxBlock, evaluated);
+        if (move.delta <= 0) {
+            ++k;
+            continue;
+        }
+        LocalSearch::apply(state, move);
+        ++moves;
+        k = SWAP;
+    }
+    if (evaluations) {
+        *evaluations += evaluated;
+    }
+    return moves;
+}
+
+///
+/// \brief Runs a single VNS trajectory from a random sequence and assigns the best
+///        sequence found to bestSequence.
+/// \param bestSequence: Assigned to be the result upon completion.
+/// \param gen: Random generator.
+/// \param s: Settings for the solver.
+///
+void VNSSolver::solveThread(Output &bestSequence, std::mt19937_64 &gen, const Settings &s) {
+    FixedScheduleState state(input, randomSequence(input, gen));
+    search(state, bestSequence, gen, s);
+}
+
+///
+/// \brief Keeps searching until the control asks to stop. A restart begins from the
+///        shared incumbent if another thread or solver found a better sequence than
+///        this thread, and from a random sequence otherwise.
+/// \param bestSequence: Assigned to be the best sequence found by this thread.
+/// \param gen: Random generator.
+/// \param control: Deadline and incumbent shared with other solvers.
+///
+void VNSSolver::runThread(Output &bestSequence, std::mt19937_64 &gen, SolveControl &control) {
+    FixedScheduleState state(input, randomSequence(input, gen));
+    bestSequence = state.toOutput();
+    double maxProfit = state.getProfit();
+    Output currSequence;
+    while (!control.shouldStop()) {
+        double profit = search(state, currSequence, gen, settings, &control);
+        if (profit > maxProfit) {
+            maxProfit = profit;
+            bestSequence = currSequence;
+        }
+        control.offer(currSequence, profit);
+        if (control.getIncumbentProfit() > maxProfit && control.getIncumbent(currSequence, profit)) {
+            state.assign(currSequence.getSchedule());
+        } else {
+            state.assign(randomSequence(input, gen).getSchedule());
+        }
+    }
+}
+
+///
+/// \brief Runs a single VNS trajectory from the given state. Every shake applies k
+///        random moves to the current local optimum before descending again. The new
+///        local optimum replaces the current one if it is no worse, so the search drifts
+///        across plateaus, and k is reset to minShake if it is better; otherwise k grows
+///        by one and wraps around past maxShake. The search stops after maxNoImprove
+///        shakes without profit gain.
+/// \param state: Starting sequence, left at the current local optimum.
+/// \param bestSequence: Assigned to be the best sequence found.
+/// \param gen: Random generator.
+/// \param s: Settings for the solver.
+/// \param control: If specified, the search stops early when the control asks to stop,
+///        and improvements are offered to it as they are found.
+/// \return Profit of the best sequence found.
+///
+double VNSSolver::search(FixedScheduleState &state, Output &bestSequence, std::mt19937_64 &gen,
+                         const Settings &s, SolveControl *control) {
+    long long evaluations = 0;
+    descend(state, s.maxBlock, &evaluations);
+    bestSequence = state.toOutput();
+    double maxProfit = state.getProfit();
+    if (state.size() < 2) {
+        return maxProfit;
+    }
+
+    if (s.verbose) {
+        std::cout << "---------------- VNS SOLVE BEGIN ----------------\n";
+        std::cout << "Printing Parameters... \n" << s;
+        std::cout << "Input size == " << state.size() << '\n';
+        std::cout << "Initial local optimum == " << maxProfit << '\n';
+    }
+
+    int minShake = std::max(1, s.minShake);
+    int maxShake = std::max(minShake, s.maxShake);
+    std::vector<int> current = state.getSequence();
+    FixedScheduleState::Value currValue = state.getValue();
+    int k = minShake;
+    int shakes = 0;
+    for (int idle = 0; idle < s.maxNoImprove && !(control && control->shouldStop()); ++shakes) {
+        shake(state, k, s.maxBlock, gen);
+        descend(state, s.maxBlock, &evaluations);
+        if (state.getValue() > currValue) {
+            k = minShake;
+        } else {
+            k = k < maxShake ? k + 1 : minShake;
+        }
+        if (state.getValue() >= currValue) {
+            current = state.getSequence();
+            currValue = state.getValue();
+        } else {
+            state.assign(current);
+        }
+
+        if (state.getProfit() - maxProfit >= PROFIT_GAIN_THRESH) {
+            idle = 0;
+        } else {
+            ++idle;
+        }
+        if (state.getProfit() > maxProfit) {
+            maxProfit = state.getProfit();
+            bestSequence = state.toOutput();
+            if (control && maxProfit > control->getIncumbentProfit()) {
+                control->offer(bestSequence, maxProfit);
+            }
+        }
+        if (s.verbose && shakes % s.printPeriod == 0) {
+            std::cout << "Shake " << shakes << ": k == " << k << ", current profit == " << state.getProfit()
+                      << ", best profit == " << maxProfit << '\n';
+        }
+    }
+    if (s.verbose) {
+        std::cout << "SEARCH IDLE, STOPPED AFTER " << shakes << " SHAKES AND " << evaluations << " EVALUATIONS.\n";
+        std::cout << "Final profit == " << maxProfit << '\n';
+        std::cout << "---------------- VNS SOLVE DONE ----------------\n";
+    }
+    return maxProfit;
+}
+
+///
+/// \brief Finds the best move of a neighbourhood with the scans of LocalSearch.
+/// \param state: Current sequence.
+/// \param type: Neighbourhood to search.
+/// \param maxBlock: Block moves shift blocks of 2 to maxBlock tasks.
+/// \param evaluations: The number of moves evaluated is added to it.
+/// \return The best move, with a delta of 0 if no move improves the profit.
+///
+LocalSearch::Move VNSSolver::bestMove(const FixedScheduleState &state, Neighbourhood type, int maxBlock,
+                                      long long &evaluations) const {
+    if (type == SWAP) {
+        return LocalSearch::bestSwap(state, &evaluations);
+    } else if (type == INSERTION) {
+        return LocalSearch::bestSegment(state, 1, 1, &evaluations);
+    }
+    return LocalSearch::bestSegment(state, 2, maxBlock, &evaluations);
+}
+
+///
+/// \brief Applies k random moves, each a swap, an insertion, or a block move with equal
+///        probability, and each starting inside the scheduled part of the sequence.
+/// \param state: Sequence to perturb.
+/// \param k: Number of moves.
+/// \param maxBlock: Block moves shift blocks of 2 to maxBlock tasks.
+/// \param gen: Random generator.
+///
+void VNSSolver::shake(FixedScheduleState &state, int k, int maxBlock, std::mt19937_64 &gen) const {
+    int n = state.size();
+    std::uniform_int_distribution<int> typeDist(SWAP, BLOCK);
+    for (int m = 0; m < k; ++m) {
+        int cutoff = std::min(state.cutoff(), n - 1);
+        int type = typeDist(gen);
+        int length = type == BLOCK ? std::uniform_int_distribution<int>(2, std::max(2, maxBlock))(gen) : 1;
+        length = std::min(length, n - 1);
+        int from = std::uniform_int_distribution<int>(0, std::min(cutoff, n - length))(gen);
+        int to = std::uniform_int_distribution<int>(0, n - length)(gen);
+        if (to == from) {
+            continue;
+        }
+        if (type == SWAP) {
+            state.applySwap(from, to);
+        } else if (length == 1) {
+            state.applyInsert(from, to);
+        } else {
+            state.applySegment(from, length, to);
+        }
+    }
+}
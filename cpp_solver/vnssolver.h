@@ -0,0 +1,83 @@
+#ifndef VNSSOLVER_H
+#define VNSSOLVER_H
+#include "input.h"
+#include "localsearch.h"
+#include "output.h"
+#include "schedulestate.h"
+#include "solver.h"
+#include <random>
+
+///
+/// \brief Variable neighbourhood search solver. Each thread descends with variable
+///        neighbourhood descent: the best swap is applied while one improves, then the
+///        best insertion, then the best block move, returning to swaps after every
+///        improvement. The local optimum is then shaken with k random moves and descended
+///        again. A better local optimum resets k to minShake, and otherwise k escalates up
+///        to maxShake before it wraps around. Moves are evaluated incrementally in
+///        fixed-point arithmetic, and threads follow independent trajectories.
+///
+class VNSSolver : public Solver
+{
+public:
+    static const int NUM_THREADS = 8;
+    struct Settings {
+        int minShake;           // Random moves of the smallest shake.
+        int maxShake;           // Random moves of the largest shake.
+        int maxBlock;           // Block moves shift blocks of 2 to maxBlock tasks.
+        int maxNoImprove;       // Number of shakes allowed with no profit gain.
+        bool verbose;           // Prints all details if set to true. May not work properly if NUM_THREADS is more than 1.
+        int printPeriod;        // Print a summary every this number of shakes.
+
+        Settings(int minShake = 1,
+                 int maxShake = 8,
+                 int maxBlock = 3,
+                 int maxNoImprove = 400,
+                 bool verbose = false,
+                 int printPeriod = 100) {
+            this->minShake = minShake;
+            this->maxShake = maxShake;
+            this->maxBlock = maxBlock;
+            this->maxNoImprove = maxNoImprove;
+            this->verbose = verbose;
+            this->printPeriod = printPeriod;
+        }
+
+        friend std::ostream& operator <<(std::ostream& out, const Settings& s) {
+            out << "GLOBAL NUM_THREADS == " << VNSSolver::NUM_THREADS << '\n';
+            out << "Min shake == " << s.minShake << '\n';
+            out << "Max shake == " << s.maxShake << '\n';
+            out << "Max block length == " << s.maxBlock << '\n';
+            out << "Max shakes with no profit gain == " << s.maxNoImprove << '\n';
+            return out;
+        }
+    };
+
+    enum Neighbourhood { SWAP, INSERTION, BLOCK, NUM_NEIGHBOURHOODS };
+
+private:
+    Input input;
+    Settings settings;
+    const double PROFIT_GAIN_THRESH = 1e-3;     // No profit is considered gained if less than this value.
+
+public:
+    VNSSolver();
+    VNSSolver(const Input& in, const Settings& s = Settings());
+
+    Output solve(int seed = 0, Settings s = Settings());
+
+    std::string name() const override;
+    Output run(int seed, int numThreads, SolveControl& control) override;
+
+    int descend(FixedScheduleState& state, int maxBlock, long long* evaluations = nullptr) const;
+
+private:
+    void solveThread(Output& bestSequence, std::mt19937_64& gen, const Settings& s);
+    void runThread(Output& bestSequence, std::mt19937_64& gen, SolveControl& control);
+    double search(FixedScheduleState& state, Output& bestSequence, std::mt19937_64& gen,
+                  const Settings& s, SolveControl* control = nullptr);
+    LocalSearch::Move bestMove(const FixedScheduleState& state, Neighbourhood type, int maxBlock,
+                               long long& evaluations) const;
+    void shake(FixedScheduleState& state, int k, int maxBlock, std::mt19937_64& gen) const;
+};
+
+#endif // VNSSOLVER_H